@@ -0,0 +1,371 @@
+/*
+ * mbed_lcd_bench.c
+ *
+ * Rendering micro-benchmarks for host build (MBED_LCD_HOST + MBED_LCD_PROFILE), see Makefile
+ * Output is CSV, one line per primitive or scene, values are per call (per frame for scenes):
+ *   ns        - wall time
+ *   pixels    - pixels covered by one call (counted at emulated LCD), scenes: 0
+ *   mpix_s    - millions of pixels per second
+ *   fb_bytes  - bytes of Video RAM written
+ *   spi_cmd   - command bytes sent to LCD
+ *   spi_data  - data bytes sent to LCD
+ *   checksum  - picture after BENCH_CHECK_CALLS calls from empty display, compared with reference
+ *   cache_hit - glyph cache hits in % of lookups during timing, only with MBED_LCD_GLYPH_CACHE (make bench-cache),
+ *               empty when case does not draw shifted text
+ * Exit code is 1 when some picture differs from reference, eg. optimization broke drawing
+ */
+
+#include "mbed_shield_lcd.h"
+#include "mbed_shield_lcd_host.h"
+#include "font_mini6.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_MIN_NS    50000000ULL       ///< Minimal measured time for each case (50 ms)
+#define BENCH_CHECK_CALLS 63              ///< Calls of case before checksum of picture (odd - toggling cases end black)
+
+#ifdef MBED_LCD_GLYPH_CACHE
+#define BENCH_CACHE_COLUMN ",cache_hit"
+#else
+#define BENCH_CACHE_COLUMN ""
+#endif
+
+typedef void (*BenchFunc_t)(uint32_t i);
+
+static uint64_t BENCH_Now(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/**
+ * Count black pixels of one call - draw to empty Video RAM and read them back from emulated LCD
+ */
+static uint32_t BENCH_Pixels(BenchFunc_t func)
+{
+  ST7565_EMU_t *emu = MBED_LCD_HostGetEmu();
+  uint32_t cnt = 0;
+
+  MBED_LCD_InitVideoRam(0x00);
+  func(0);
+  MBED_LCD_VideoRam2LCD();
+
+  for (uint8_t y = 0; y < MBED_LCD_GetRows(); y++)
+    for (uint8_t x = 0; x < MBED_LCD_GetColumns(); x++)
+      if (ST7565_EMU_GetPixel(emu, x, y))
+        cnt++;
+
+  return cnt;
+}
+
+/**
+ * Checksum (FNV-1a) of picture at emulated LCD after BENCH_CHECK_CALLS calls over text background
+ * Full refresh must give same picture as refresh of changes, returns 0 when it does not
+ */
+static uint32_t BENCH_Checksum(BenchFunc_t func)
+{
+  static char text[] = "Checksum of picture - 0123456789";
+  ST7565_EMU_t *emu = MBED_LCD_HostGetEmu();
+  uint32_t sum[2];
+
+  MBED_LCD_InitVideoRam(0x00);
+  for (uint8_t r = 0; r < MBED_LCD_GetLines(); r++)     // moved, copied and inverted areas differ from empty
+    MBED_LCD_WriteStringCR(&text[r * 4], 0, r);
+  MBED_LCD_VideoRam2LCD();
+  for (uint32_t n = 0; n < BENCH_CHECK_CALLS; n++)
+    func(n);
+
+  for (int pass = 0; pass < 2; pass++)
+  {
+    MBED_LCD_VideoRam2LCD();
+    sum[pass] = 2166136261u;
+    for (uint8_t y = 0; y < MBED_LCD_GetRows(); y++)
+      for (uint8_t x = 0; x < MBED_LCD_GetColumns(); x++)
+        sum[pass] = (sum[pass] ^ ST7565_EMU_GetPixel(emu, x, y)) * 16777619u;
+    MBED_LCD_Invalidate();
+  }
+
+  return (sum[0] == sum[1]) ? sum[0] : 0;
+}
+
+static int m_failed;
+
+/**
+ * Run case repeatedly for at least BENCH_MIN_NS and print CSV line
+ * Checksum goes before timing, so state of case (chart, field, console) is the same in each run
+ */
+static void BENCH_Run(const char *kind, const char *name, BenchFunc_t func, bool countPixels, uint32_t reference)
+{
+  uint32_t pixels = countPixels ? BENCH_Pixels(func) : 0;
+  uint32_t checksum = BENCH_Checksum(func);
+  uint32_t iter = 0;
+  uint64_t t0, t;
+  MBED_LCD_Profile_t prof;
+#ifdef MBED_LCD_GLYPH_CACHE
+  MBED_LCD_GlyphCacheStats_t cache0, cache;
+#endif
+
+  MBED_LCD_InitVideoRam(0x00);
+  MBED_LCD_VideoRam2LCD();
+  MBED_LCD_ClearProfile();
+#ifdef MBED_LCD_GLYPH_CACHE
+  MBED_LCD_GetGlyphCacheStats(&cache0);                 // cache stays warm from checksum, only timed lookups count
+#endif
+
+  t0 = BENCH_Now();
+  do
+  {
+    for (uint32_t n = 0; n < 64; n++, iter++)
+      func(iter);
+    t = BENCH_Now() - t0;
+  } while (t < BENCH_MIN_NS);
+
+  MBED_LCD_GetProfile(&prof);
+
+  printf("%s,%s,%u,%.1f,%u,%.2f,%.1f,%.1f,%.1f,%08X", kind, name, iter,
+      (double)t / iter, pixels, (t > 0) ? (double)pixels * iter * 1000.0 / t : 0.0,
+      (double)prof.fbBytes / iter, (double)prof.spiCommands / iter, (double)prof.spiData / iter, checksum);
+#ifdef MBED_LCD_GLYPH_CACHE
+  MBED_LCD_GetGlyphCacheStats(&cache);
+  {
+    uint32_t hits = cache.hits - cache0.hits;
+    uint32_t lookups = hits + cache.misses - cache0.misses;
+
+    if (lookups > 0)
+      printf(",%.1f", hits * 100.0 / lookups);
+    else
+      printf(",");
+  }
+#endif
+  printf("\n");
+
+  if (checksum != reference)
+  {
+    fprintf(stderr, "%s: checksum %08X, expected %08X\n", name, checksum, reference);
+    m_failed++;
+  }
+}
+
+/**
+ * Primitives - single call, no refresh
+ */
+static void P_DrawCircle(uint32_t i)    { MBED_LCD_DrawCircle(64, 16, 12, !(i & 1)); }
+static void P_FillCircle(uint32_t i)    { MBED_LCD_FillCircle(64, 16, 12, !(i & 1)); }
+static void P_FillRect(uint32_t i)      { MBED_LCD_FillRect(10, 3, 100, 26, !(i & 1)); }
+static void P_FillScreen(uint32_t i)    { MBED_LCD_FillRect(0, 0, MBED_LCD_GetColumns(), MBED_LCD_GetRows(), !(i & 1)); }
+static void P_DrawLine(uint32_t i)      { MBED_LCD_DrawLine(0, 0, 127, 31, !(i & 1)); }
+static void P_DrawHLine(uint32_t i)     { MBED_LCD_DrawLine(0, 13, 127, 13, !(i & 1)); }
+static void P_DrawRect(uint32_t i)      { MBED_LCD_DrawRect(5, 3, 100, 25, !(i & 1)); }
+static void P_StringAligned(uint32_t i) { (void)i; MBED_LCD_WriteStringXY("Bench 12", 0, 8); }
+static void P_StringShifted(uint32_t i) { (void)i; MBED_LCD_WriteStringXY("Bench 12", 0, 11); }
+static void P_TextMini6(uint32_t i) { (void)i; MBED_LCD_SetFont(&MBED_LCD_FontMini6); MBED_LCD_DrawText(0, 11, "Bench 12"); MBED_LCD_SetFont(NULL); }
+
+static MBED_LCD_Field_t m_field;        // counter, mostly only last digit changes
+static void P_FieldNumber(uint32_t i)   { MBED_LCD_FieldSetNumber(&m_field, 12340 + i); }
+static void P_SprintfNumber(uint32_t i) { char buf[16]; sprintf(buf, "%6d", (int)(12340 + i)); MBED_LCD_WriteStringXY(buf, 0, 8); }
+
+static MBED_LCD_ChartSample_t m_chartBuf[100];
+static MBED_LCD_Chart_t m_chart;        // 100 x 24, full ring, fixed range
+static int16_t m_lineBuf[100];
+static void P_ChartAdd(uint32_t i)      { MBED_LCD_ChartAdd(&m_chart, (i * 7) % 40); }
+static void P_ChartLines(uint32_t i)    // same chart by clear and lines
+{
+  m_lineBuf[i % 100] = (i * 7) % 40;
+  MBED_LCD_FillRect(10, 4, 100, 24, false);
+  for (int n = 1; n < 100; n++)
+    MBED_LCD_DrawLine(10 + n - 1, 27 - m_lineBuf[(i + n) % 100] * 23 / 40, 10 + n, 27 - m_lineBuf[(i + n + 1) % 100] * 23 / 40, true);
+}
+
+static uint8_t m_sprite[8] = { 0x18, 0x3C, 0x7E, 0xFF, 0xFF, 0x7E, 0x3C, 0x18 };
+static void P_Sprite(uint32_t i)        { MBED_LCD_DrawSpriteMono8(60, 13, m_sprite, 8, !(i & 1)); }
+
+static uint8_t m_icon[4 * 32];                  // 32x32 page format, pattern filled in main()
+static const MBED_LCD_Bitmap_t m_iconBmp = { 32, 32, MBED_LCD_BMP_PAGES, m_icon, NULL };
+static void P_BitmapXor(uint32_t i)     { (void)i; MBED_LCD_DrawBitmap(40, 3, &m_iconBmp, MBED_LCD_ROP_XOR); }
+static void P_InvertRect(uint32_t i)    { (void)i; MBED_LCD_InvertRect(10, 3, 100, 26); }
+static void P_CopyRect(uint32_t i)      { MBED_LCD_CopyRect(10, 3, 50, 20, 12 + (i & 1) * 50, 6); }
+static void P_ScrollLeft(uint32_t i)    { (void)i; MBED_LCD_Scroll(-1, 0, false); }
+
+static uint8_t m_saved[MBED_LCD_RECT_SIZE(40, 20)];
+static void P_SaveRestore(uint32_t i)   { (void)i; MBED_LCD_SaveRect(30, 5, 40, 20, m_saved); MBED_LCD_RestoreRect(31, 5, 40, 20, m_saved); }
+
+/**
+ * Refresh - full frame and single changed character
+ */
+static void R_Full(uint32_t i)
+{
+  (void)i;
+  MBED_LCD_Invalidate();
+  MBED_LCD_VideoRam2LCD();
+}
+
+static void R_OneChar(uint32_t i)
+{
+  MBED_LCD_WriteCharCR('0' + (i % 10), 5, 2);
+  MBED_LCD_VideoRam2LCD();
+}
+
+static void R_Idle(uint32_t i)
+{
+  (void)i;
+  MBED_LCD_VideoRam2LCD();
+}
+
+/**
+ * Scenes - whole frame including refresh
+ */
+static void S_Clear(uint32_t i)
+{
+  MBED_LCD_InitVideoRam((i & 1) ? 0xFF : 0x00);
+  MBED_LCD_VideoRam2LCD();
+}
+
+static void S_Console(uint32_t i)
+{
+  char line[24];
+
+  for (uint8_t r = 0; r < MBED_LCD_GetLines(); r++)
+  {
+    snprintf(line, sizeof(line), "log %05u row %u", (unsigned)(i + r), r);
+    MBED_LCD_WriteStringCR(line, 0, r);
+  }
+  MBED_LCD_VideoRam2LCD();
+}
+
+static void S_ConsoleScroll(uint32_t i)
+{
+  char line[24];
+
+  snprintf(line, sizeof(line), "\nlog %05u", (unsigned)i);
+  MBED_LCD_ConsoleWrite(line);                // one new line = hardware scroll
+  MBED_LCD_VideoRam2LCD();
+}
+
+static void S_Gauge(uint32_t i)
+{
+  static const int8_t needle[16][2] =         // end points of needle, radius 14
+  {
+    { -14, 0 }, { -14, -3 }, { -13, -5 }, { -12, -8 }, { -10, -10 }, { -8, -12 }, { -5, -13 }, { -3, -14 },
+    { 0, -14 }, { 3, -14 }, { 5, -13 }, { 8, -12 }, { 10, -10 }, { 12, -8 }, { 13, -5 }, { 14, -3 }
+  };
+  uint32_t v = i % 16;
+  char txt[8];
+
+  MBED_LCD_FillRect(0, 0, 40, 32, false);
+  MBED_LCD_DrawCircle(20, 30, 15, true);
+  MBED_LCD_DrawLine(20, 30, 20 + needle[v][0], 30 + needle[v][1], true);
+
+  MBED_LCD_DrawRect(48, 20, 78, 10, true);      // bar graph
+  MBED_LCD_FillRect(49, 21, 77, 9, false);
+  MBED_LCD_FillRect(49, 21, v * 77 / 15, 9, true);
+
+  snprintf(txt, sizeof(txt), "%3u%%", (unsigned)(v * 100 / 15));
+  MBED_LCD_WriteStringXY(txt, 48, 4);
+  MBED_LCD_VideoRam2LCD();
+}
+
+static void S_Sprites(uint32_t i)
+{
+  for (int s = 0; s < 4; s++)                   // 4 sprites moving horizontaly
+  {
+    int x = (i * (s + 1) + s * 30) % 120;
+    int y = s * 8;
+
+    MBED_LCD_FillRect(0, y, 128, 8, false);
+    MBED_LCD_DrawSpriteMono8(x, y, m_sprite, 8, true);
+  }
+  MBED_LCD_VideoRam2LCD();
+}
+
+static void S_Menu(uint32_t i)
+{
+  static const char *items[] = { "Contrast", "Backlight", "Invert", "Power off", "About" };
+  uint32_t sel = i % 8;
+
+  if (sel == 0)                                 // whole list drawn once, then only moving bar
+  {
+    MBED_LCD_InitVideoRam(0x00);
+    for (int n = 0; n < 4; n++)
+      MBED_LCD_WriteStringXY((char *)items[n], 8, n * 8);
+    MBED_LCD_InvertRect(0, 0, 128, 8);
+  }
+  else if (sel < 4)
+  {
+    MBED_LCD_InvertRect(0, (sel - 1) * 8, 128, 8);
+    MBED_LCD_InvertRect(0, sel * 8, 128, 8);
+  }
+  else                                          // list scrolls by pixels, new item at bottom
+  {
+    MBED_LCD_SetClip(0, 0, 128, 32);
+    MBED_LCD_Scroll(0, -2, false);
+    MBED_LCD_WriteStringXY((char *)items[4], 8, 24 + (8 - sel) * 2);
+  }
+  MBED_LCD_VideoRam2LCD();
+}
+
+static void S_Ticker(uint32_t i)
+{
+  static const char text[] = "News ticker moves by one pixel ... ";
+
+  MBED_LCD_SetClip(0, 12, 128, 8);              // one line of text, rest of display is not touched
+  MBED_LCD_Scroll(-1, 0, false);
+  if ((i % 8) == 0)
+    MBED_LCD_WriteCharXY(text[(i / 8) % (sizeof(text) - 1)], 120, 12);
+  MBED_LCD_ResetClip();
+  MBED_LCD_VideoRam2LCD();
+}
+
+int main(void)
+{
+  if (!MBED_LCD_init())
+    return 1;
+
+  for (unsigned n = 0; n < sizeof(m_icon); n++)
+    m_icon[n] = 0x5A ^ n;
+
+  MBED_LCD_FieldInit(&m_field, 0, 8, 6, 0, 0);
+  MBED_LCD_ChartInit(&m_chart, 10, 4, 100, 24, m_chartBuf, 0, 40, false);
+  for (unsigned n = 0; n < 100; n++)
+    MBED_LCD_ChartAdd(&m_chart, (n * 7) % 40);
+
+  printf("kind,name,iterations,ns,pixels,mpix_s,fb_bytes,spi_cmd,spi_data,checksum" BENCH_CACHE_COLUMN "\n");
+
+  BENCH_Run("primitive", "DrawCircle_r12", P_DrawCircle, true, 0xB5394385);
+  BENCH_Run("primitive", "FillCircle_r12", P_FillCircle, true, 0x88A093F2);
+  BENCH_Run("primitive", "FillRect_100x26", P_FillRect, true, 0x25352F96);
+  BENCH_Run("primitive", "FillRect_screen", P_FillScreen, true, 0xCD28EDC5);
+  BENCH_Run("primitive", "DrawLine_diag", P_DrawLine, true, 0xEC2EAB61);
+  BENCH_Run("primitive", "DrawLine_horiz", P_DrawHLine, true, 0xEC4301B1);
+  BENCH_Run("primitive", "DrawRect_100x25", P_DrawRect, true, 0xFCD4244F);
+  BENCH_Run("primitive", "WriteStringXY_aligned", P_StringAligned, true, 0x7CD662E9);
+  BENCH_Run("primitive", "WriteStringXY_shifted", P_StringShifted, true, 0x3AD98B29);
+  BENCH_Run("primitive", "DrawText_mini6", P_TextMini6, true, 0xE9FCE02B);
+  BENCH_Run("primitive", "FieldSetNumber_counter", P_FieldNumber, true, 0x178CEB3B);
+  BENCH_Run("primitive", "sprintf_WriteStringXY", P_SprintfNumber, true, 0xB3E38956);
+  BENCH_Run("primitive", "ChartAdd_100x24", P_ChartAdd, true, 0xD137EF73);
+  BENCH_Run("primitive", "Chart_clear_lines_100x24", P_ChartLines, true, 0x21000163);
+  BENCH_Run("primitive", "DrawSpriteMono8", P_Sprite, true, 0xE5300BDB);
+  BENCH_Run("primitive", "DrawBitmap_32x32_xor", P_BitmapXor, true, 0x34F6FE49);
+  BENCH_Run("primitive", "InvertRect_100x26", P_InvertRect, true, 0x5D93D705);
+  BENCH_Run("primitive", "CopyRect_50x20", P_CopyRect, true, 0x01EB970F);
+  BENCH_Run("primitive", "Scroll_left_1", P_ScrollLeft, true, 0x1292C9BF);
+  BENCH_Run("primitive", "SaveRestore_40x20", P_SaveRestore, true, 0x69BE9593);
+
+  BENCH_Run("refresh", "VideoRam2LCD_full", R_Full, false, 0x8AD40BA1);
+  BENCH_Run("refresh", "VideoRam2LCD_one_char", R_OneChar, false, 0x9109AFBD);
+  BENCH_Run("refresh", "VideoRam2LCD_idle", R_Idle, false, 0x8AD40BA1);
+
+  BENCH_Run("scene", "clear", S_Clear, false, 0x76EFDDC5);
+  BENCH_Run("scene", "console", S_Console, false, 0x164B9120);
+  BENCH_Run("scene", "console_scroll", S_ConsoleScroll, false, 0xB03FAD90);
+  BENCH_Run("scene", "gauge", S_Gauge, false, 0xC995FF6C);
+  BENCH_Run("scene", "sprites", S_Sprites, false, 0x4FB2A2E5);
+  BENCH_Run("scene", "menu", S_Menu, false, 0x7C968F57);
+  BENCH_Run("scene", "ticker", S_Ticker, false, 0x6107B275);
+
+  return (m_failed > 0) ? 1 : 0;
+}
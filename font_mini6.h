@@ -0,0 +1,46 @@
+/* MBED_LCD_FontMini6 - tools/fonts/mini6.bdf, 95 glyphs, 6 rows, proportional, 268 bytes of glyphs */
+#include <stddef.h>
+#include "mbed_shield_lcd.h"
+
+static const uint8_t MBED_LCD_FontMini6_data[268] =
+{
+  0x00, 0x00, 0x00, 0x17, 0x03, 0x00, 0x03, 0x1F, 0x0A, 0x1F, 0x12, 0x1F, 0x09, 0x19, 0x04, 0x13,
+  0x0A, 0x15, 0x1A, 0x03, 0x0E, 0x11, 0x11, 0x0E, 0x0A, 0x04, 0x0A, 0x04, 0x0E, 0x04, 0x10, 0x08,
+  0x04, 0x04, 0x04, 0x10, 0x18, 0x04, 0x03, 0x1F, 0x11, 0x1F, 0x12, 0x1F, 0x10, 0x1D, 0x15, 0x17,
+  0x11, 0x15, 0x1F, 0x07, 0x04, 0x1F, 0x17, 0x15, 0x1D, 0x1F, 0x15, 0x1D, 0x01, 0x1D, 0x03, 0x1F,
+  0x15, 0x1F, 0x17, 0x15, 0x1F, 0x0A, 0x10, 0x0A, 0x04, 0x0A, 0x11, 0x0A, 0x0A, 0x0A, 0x11, 0x0A,
+  0x04, 0x01, 0x15, 0x03, 0x0E, 0x15, 0x16, 0x1E, 0x05, 0x1E, 0x1F, 0x15, 0x0A, 0x0E, 0x11, 0x11,
+  0x1F, 0x11, 0x0E, 0x1F, 0x15, 0x11, 0x1F, 0x05, 0x01, 0x0E, 0x11, 0x1D, 0x1F, 0x04, 0x1F, 0x11,
+  0x1F, 0x11, 0x08, 0x10, 0x0F, 0x1F, 0x04, 0x1B, 0x1F, 0x10, 0x10, 0x1F, 0x06, 0x1F, 0x1F, 0x01,
+  0x1E, 0x0E, 0x11, 0x0E, 0x1F, 0x05, 0x02, 0x0E, 0x19, 0x16, 0x1F, 0x05, 0x1A, 0x12, 0x15, 0x09,
+  0x01, 0x1F, 0x01, 0x1F, 0x10, 0x1F, 0x0F, 0x10, 0x0F, 0x1F, 0x0C, 0x1F, 0x1B, 0x04, 0x1B, 0x03,
+  0x1C, 0x03, 0x19, 0x15, 0x13, 0x1F, 0x11, 0x03, 0x04, 0x18, 0x11, 0x1F, 0x02, 0x01, 0x02, 0x10,
+  0x10, 0x10, 0x01, 0x02, 0x1E, 0x05, 0x1E, 0x1F, 0x15, 0x0A, 0x0E, 0x11, 0x11, 0x1F, 0x11, 0x0E,
+  0x1F, 0x15, 0x11, 0x1F, 0x05, 0x01, 0x0E, 0x11, 0x1D, 0x1F, 0x04, 0x1F, 0x11, 0x1F, 0x11, 0x08,
+  0x10, 0x0F, 0x1F, 0x04, 0x1B, 0x1F, 0x10, 0x10, 0x1F, 0x06, 0x1F, 0x1F, 0x01, 0x1E, 0x0E, 0x11,
+  0x0E, 0x1F, 0x05, 0x02, 0x0E, 0x19, 0x16, 0x1F, 0x05, 0x1A, 0x12, 0x15, 0x09, 0x01, 0x1F, 0x01,
+  0x1F, 0x10, 0x1F, 0x0F, 0x10, 0x0F, 0x1F, 0x0C, 0x1F, 0x1B, 0x04, 0x1B, 0x03, 0x1C, 0x03, 0x19,
+  0x15, 0x13, 0x04, 0x1F, 0x11, 0x1F, 0x11, 0x1F, 0x04, 0x04, 0x06, 0x02
+};
+
+static const uint8_t MBED_LCD_FontMini6_widths[95] =
+{
+   3,  1,  3,  3,  3,  3,  3,  1,  2,  2,  3,  3,  2,  3,  1,  3,
+   3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  1,  2,  3,  3,  3,  3,
+   3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,
+   3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  2,  3,  2,  3,  3,
+   2,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,
+   3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  1,  3,  3
+};
+
+static const uint16_t MBED_LCD_FontMini6_offsets[95] =
+{
+     0,    3,    4,    7,   10,   13,   16,   19,   20,   22,   24,   27,   30,   32,   35,   36,
+    39,   42,   45,   48,   51,   54,   57,   60,   63,   66,   69,   70,   72,   75,   78,   81,
+    84,   87,   90,   93,   96,   99,  102,  105,  108,  111,  114,  117,  120,  123,  126,  129,
+   132,  135,  138,  141,  144,  147,  150,  153,  156,  159,  162,  165,  167,  170,  172,  175,
+   178,  180,  183,  186,  189,  192,  195,  198,  201,  204,  207,  210,  213,  216,  219,  222,
+   225,  228,  231,  234,  237,  240,  243,  246,  249,  252,  255,  258,  261,  262,  265
+};
+
+const MBED_LCD_Font_t MBED_LCD_FontMini6 = { 6, 3, 1, 31, 32, 95, NULL, MBED_LCD_FontMini6_widths, MBED_LCD_FontMini6_offsets, MBED_LCD_FontMini6_data };
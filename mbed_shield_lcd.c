@@ -1,738 +1,3953 @@
-/**
- * Include common core function, must contain setGPIO, setAF, GPIOWrite
- */
-#include "stm_core.h"
-#include "mbed_shield_lcd.h"
-
-#ifndef NULL                // maybe required for "invalid value"
-#define NULL  ((void *)0)
-#endif
-
-#ifndef BB_REG
-#define BB_REG(reg, bit) (*(uint32_t *)(PERIPH_BB_BASE + ((uint32_t)(&(reg)) - PERIPH_BASE) * 32 + 4 * (bit)))
-#define BB_RAM(adr, bit) (*(uint32_t *)(SRAM_BB_BASE + ((uint32_t)(adr) - SRAM_BASE) * 32 + 4 * (bit)))
-#endif
-
-/**
- * Global settings - enable DMA, nable/set timer for auto-refresh
- */
-#ifndef USE_DMA_REFRESH
-#warning DMA auto refresh is not used. Do not forget to call MBED_LCD_VideoRam2LCD() after changing the frame-buffer content
-#endif
-#define REFRESH_TIMER 4
-
-/**
- * Used SPI channel
- */
-#define _MBED_LCD_SPI         SPI1
-/**
- * Alternate Funcion number for GPIO AF signals (SCK and MOSI)
- */
-#define _MBED_LCD_SPI_AF_NUM  5
-/**
- * Definition of GPIO ports for concrete control signals
- */
-#define _MBED_LCD_SPI_SCK         GPIOA,5   ///< SPI clock
-#define _MBED_LCD_SPI_MOSI        GPIOA,7   ///< SPI MOSI signal
-#define _MBED_LCD_PIN_RSTN_PORT   GPIOA     ///< display RST signal, active in LO
-#define _MBED_LCD_PIN_RSTN_PIN    6
-#define _MBED_LCD_PIN_CSN_PORT    GPIOB     ///< display CS signal, active in LO
-#define _MBED_LCD_PIN_CSN_PIN     6
-#define _MBED_LCD_PIN_A0_PORT     GPIOA     ///< display A0 signal, LO = commands, HI = data
-#define _MBED_LCD_PIN_A0_PIN      8
-
-/**
- * Differencies between platforms
- * !! not completed, can emit error
- */
-#if defined(STM32F4)
-#define SPI_IS_BUSY(SPIx) (((SPIx)->SR & (SPI_SR_TXE | SPI_SR_RXNE)) == 0 || ((SPIx)->SR & SPI_SR_BSY))
-//TODO #elseif another platform, for example - F103: SPIx->SR & SPI_SR_BSY
-#else
-#error Not supported platform
-#endif
-
-/**
- * Physical dimensions of LCD, controler can support 132x64 max
- */
-#define _MBED_LCD_COLUMNS   128           ///< Horizontal pixels count
-#define _MBED_LCD_ROWS      32            ///< Vertical pixels couns
-#define _MBED_LCD_LINES     (_MBED_LCD_ROWS / 8)              ///< Count of 8x8 chars horizontaly
-#define _MBED_LCD_CHAR_PER_LINE     (_MBED_LCD_COLUMNS / 8)   ///< Count of 8x8 chars verticaly
-
-/**
- * Returns count of pixel horizontaly
- */
-inline uint8_t MBED_LCD_GetColumns(void)
-{
-  return _MBED_LCD_COLUMNS;
-}
-
-/**
- * Return count of pixel verticaly
- */
-inline uint8_t MBED_LCD_GetRows(void)
-{
-  return _MBED_LCD_ROWS;
-}
-
-/**
- * Returns count of text rows with default fonr 8x8
- */
-inline uint8_t MBED_LCD_GetLines(void)
-{
-  return _MBED_LCD_LINES;
-}
-
-/**
- * Returns count of text columns with default fonr 8x8
- */
-inline uint8_t MBED_LCD_GetCharPerLine(void)
-{
-  return _MBED_LCD_CHAR_PER_LINE;
-}
-
-/**
- *  Private memory buffer
- *  Reuqired LINES * COLUMNS bytes at BSS segment
- */
-static uint8_t m_videoRam[_MBED_LCD_LINES][_MBED_LCD_COLUMNS];
-static volatile bool _refreshInProgress = false;
-
-/**
- * Private funcions
- */
-static void MBED_LCD_send(uint8_t val, bool a0)       ///< Write single value to LCD - using SPI, A0 selects CMD = 0, DATA = 1
-{
-  BB_REG(_MBED_LCD_PIN_A0_PORT->ODR, _MBED_LCD_PIN_A0_PIN) = a0 ? 1 : 0;
-  BB_REG(_MBED_LCD_PIN_CSN_PORT->ODR, _MBED_LCD_PIN_CSN_PIN) = 0;
-
-  _MBED_LCD_SPI->DR = val;
-  while(SPI_IS_BUSY(_MBED_LCD_SPI))                   // waiting is different fo F4xx and another Fxxx
-    ;                                                 // blocking waiting
-
-  BB_REG(_MBED_LCD_PIN_CSN_PORT->ODR, _MBED_LCD_PIN_CSN_PIN) = 1;
-}
-
-#ifndef USE_DMA_REFRESH
-/**
- * Send data block manually
- */
-static void MBED_LCD_sendData(uint8_t *val, uint16_t len)   ///< Write block of data, pointer to start and length
-{
-  BB_REG(_MBED_LCD_PIN_A0_PORT->ODR, _MBED_LCD_PIN_A0_PIN) = 1;      // always data
-  BB_REG(_MBED_LCD_PIN_CSN_PORT->ODR, _MBED_LCD_PIN_CSN_PIN) = 0;
-
-  for(; len; len--)
-  {
-    _MBED_LCD_SPI->DR = *val;
-    val++;
-
-    while(_MBED_LCD_SPI->SR & SPI_SR_BSY)               // blocking wait
-      ;
-  }
-
-  BB_REG(_MBED_LCD_PIN_CSN_PORT->ODR, _MBED_LCD_PIN_CSN_PIN) = 1;
-}
-#endif
-
-static bool MBED_LCD_reset(void)                        ///< Perform reset sequence
-{
-  uint16_t w, x = 0;
-
-  BB_REG(_MBED_LCD_PIN_A0_PORT->ODR, _MBED_LCD_PIN_A0_PIN) = 0;
-  BB_REG(_MBED_LCD_PIN_RSTN_PORT->ODR, _MBED_LCD_PIN_RSTN_PIN) = 0;
-
-  for(w = 0; w < 10000; w++)
-    x++;                                                // Dummy increment prevents optimalisation
-
-  BB_REG(_MBED_LCD_PIN_RSTN_PORT->ODR, _MBED_LCD_PIN_RSTN_PIN) = 1;
-
-  for(w = 0; w < 1000; w++)
-    x++;
-
-  return (x > 0);                                       // Trick to keep vaiable unoptimalised ...
-}
-
-static void MBED_LCD_set_start_line(uint8_t x)          ///< Send command to LCD, info from DS
-{
-  MBED_LCD_send(0x10 | ((x & 0xf0) >> 4), 0);           // (2) Display start line set = Sets the display RAM display start lineaddress - lower 6 bits
-  MBED_LCD_send(0x00 | (x & 0x0f), 0);                  // (2) Display start line set = Sets the display RAM display start lineaddress - lower 6 bits
-}
-
-static void MBED_LCD_set_page(uint8_t p)                ///< Send command to LCD, info from DS
-{
-   MBED_LCD_send(0xB0 | (p & 0x0f), 0);                 // (3) Page address set = Sets the display RAM page address - lower 4 bits
-}
-
-static bool _MBED_LCD_init_hw()                         ///< Init SPI, GPIO, ...
-{
-  STM_SetPinGPIO(_MBED_LCD_PIN_RSTN_PORT, _MBED_LCD_PIN_RSTN_PIN, ioPortOutputPP);
-  BB_REG(_MBED_LCD_PIN_RSTN_PORT->ODR, _MBED_LCD_PIN_RSTN_PIN) = 1;
-  STM_SetPinGPIO(_MBED_LCD_PIN_CSN_PORT, _MBED_LCD_PIN_CSN_PIN, ioPortOutputPP);
-  BB_REG(_MBED_LCD_PIN_CSN_PORT->ODR, _MBED_LCD_PIN_CSN_PIN) = 1;
-  STM_SetPinGPIO(_MBED_LCD_PIN_A0_PORT, _MBED_LCD_PIN_A0_PIN, ioPortOutputPP);
-
-  STM_SetPinGPIO(_MBED_LCD_SPI_MOSI, ioPortAlternatePP);
-  STM_SetAFGPIO(_MBED_LCD_SPI_MOSI, _MBED_LCD_SPI_AF_NUM);        // AFxx
-  STM_SetPinGPIO(_MBED_LCD_SPI_SCK, ioPortAlternatePP);
-  STM_SetAFGPIO(_MBED_LCD_SPI_SCK, _MBED_LCD_SPI_AF_NUM);         // AFxx
-
-  switch((uint32_t)_MBED_LCD_SPI)                       // Switch reuired due using ohter APBx for some SPIx
-  {
-    case (uint32_t)SPI1:
-      if (!(RCC->APB2ENR & RCC_APB2ENR_SPI1EN))
-      {
-        RCC->APB2ENR |= RCC_APB2ENR_SPI1EN;
-        RCC->APB2RSTR |= RCC_APB2RSTR_SPI1RST;
-        RCC->APB2RSTR &= ~RCC_APB2RSTR_SPI1RST;
-      }
-      break;
-    //TODO other SPIx peripheral
-    default:
-      return false;
-  }
-
-  _MBED_LCD_SPI->CR1 = 0
-      | SPI_CR1_CPHA | SPI_CR1_CPOL     // polarity from DS
-      | SPI_CR1_SSI | SPI_CR1_SSM       // required for correct function
-      | SPI_CR1_MSTR;
-  _MBED_LCD_SPI->CR2 = 0;
-
-  {                                     // from DS - max clock 10MHz (100ns period)
-//    uint32_t apb2 = SystemCoreClock;    //TODO calculate from RCC
-    uint32_t apb2 = GetBusClock(busClockAPB2);
-    uint32_t BRDiv = 0;                 // 000 = pclk / 2
-
-    if (apb2 > 20e6) BRDiv = 0x01;      // 001 = pclk / 4
-    if (apb2 > 40e6) BRDiv = 0x02;      // 010 = pclk / 8
-    if (apb2 > 80e6) BRDiv = 0x03;      // 011 = pclk / 16
-
-    _MBED_LCD_SPI->CR1 &= ~SPI_CR1_BR;
-    //  only for F4xx:
-    _MBED_LCD_SPI->CR1 |= (BRDiv & 0x07) << 3;    // isolate 3 bits and set to bits 5..3
-    //TODO another platforms
-  }
-
-  _MBED_LCD_SPI->CR1 |= SPI_CR1_SPE;             // enable
-
-  return true;
-}
-
-static bool _MBED_LCD_init_hw_refresh(void)   // call after LCD init
-{
-#ifdef USE_DMA_REFRESH
-//  bbUseDMA = false;
-  if (!(RCC->AHB1ENR & RCC_AHB1ENR_DMA2EN))
-  {
-    RCC->AHB1ENR |= RCC_AHB1ENR_DMA2EN;
-    RCC->AHB1RSTR |= RCC_AHB1RSTR_DMA2RST;
-    RCC->AHB1RSTR &= ~RCC_AHB1RSTR_DMA2RST;
-  }
-
-  NVIC_EnableIRQ(DMA2_Stream3_IRQn);
-
-#ifdef REFRESH_TIMER
-  uint32_t apb = GetTimerClock(REFRESH_TIMER);
-  if (apb != 0)     // found valid Timer ?
-  {
-    TIM_TypeDef *timPtr = NULL;
-    IRQn_Type irqN = 0;
-    switch(REFRESH_TIMER)
-    {
-      case 4:
-        if (!(RCC->APB1ENR & RCC_APB1ENR_TIM4EN))
-        {
-          RCC->APB1ENR |= RCC_APB1ENR_TIM4EN;
-          RCC->APB1RSTR |= RCC_APB1RSTR_TIM4RST;
-          RCC->APB1RSTR &= ~RCC_APB1RSTR_TIM4RST;
-        }
-
-        timPtr = TIM4;
-        irqN = TIM4_IRQn;
-        break;
-        //TODO maji jine citace jine registry ?
-      default:
-        return false;
-    }
-
-    timPtr->CR1 = TIM_CR1_URS;
-    timPtr->CR2 = 0;
-    //    TIM3->EGR = TIM_EGR_UG;
-
-    timPtr->PSC = apb / 100000 - 1;   // 100us = 10kHz
-    timPtr->ARR = 500 - 1;            // reload 5ms (500 x 0.01ms)
-
-    if (irqN > 0)
-    {
-      timPtr->DIER |= TIM_DIER_UIE;
-      NVIC_EnableIRQ(irqN);
-    }
-
-    timPtr->CR1 |= TIM_CR1_CEN;
-  }
-#endif
-  //  bbUseDMA = true;
-#endif
-
-  // zbytecne, je to vychozi hodnota ... _refreshInProgress = false;
-  return true;
-}
-
-/**
- * Area of public functions
- */
-
-/**
- * Fill videoram with value, bytes = columns, MSB on top
- */
-void MBED_LCD_InitVideoRam(uint8_t val)
-{
-  for(int r = 0; r < _MBED_LCD_LINES; r++)      // repaired 2019-09-23
-    for(int x = 0; x < _MBED_LCD_COLUMNS; x++)
-      m_videoRam[r][x] = val;
-}
-
-/**
- * Initialisation - HW parts and init commands for LCD controller (see DS and MBED sample init code)
- * Returns false if ini fails
- */
-bool MBED_LCD_init(void)
-{
-  if (!_MBED_LCD_init_hw())  // check success of HW init
-    return false;
-
-  MBED_LCD_reset();
-
-  MBED_LCD_send(0xAE, 0);   //  display off
-  MBED_LCD_send(0xA2, 0);   //  bias voltage
-
-  MBED_LCD_send(0xA0, 0);
-  MBED_LCD_send(0xC8, 0);   //  colum normal
-
-  MBED_LCD_send(0x22, 0);   //  voltage resistor ratio
-  MBED_LCD_send(0x2F, 0);   //  power on
-  //wr_cmd(0xA4);   //  LCD display ram
-  MBED_LCD_send(0x40, 0);   // start line = 0
-  MBED_LCD_send(0xAF, 0);   // display ON
-
-  MBED_LCD_send(0x81, 0);   //  set contrast
-  MBED_LCD_send(0x17, 0);   //  set contrast
-
-  MBED_LCD_send(0xA6, 0);   // display normal
-//  MBED_LCD_send(0xA7, 0);     // display inverted
-
-//  MBED_LCD_send(0xa5, 0);
-
-  _MBED_LCD_init_hw_refresh();
-  return true;                // ALL init OK
-}
-
-/**
- * Font definition - pure data for 8x8 pixel characters, 0-127 code
- */
-#include "font_8x8.h"       ///< Font defintion, 128 characters with ASCII codes 0..127
-
-/**
- * Writes 8x8 character at position - counted in "chars"
- * Return false if coordinates are outside working area
- */
-bool MBED_LCD_WriteCharCR(char c, uint8_t col, uint8_t row)
-{
-  /* old code, required for direct write byte-by-byte to "line" memory
-  int i;
-
-  if ((col > _MBED_LCD_COLUMNS / 8) || (row > (_MBED_LCD_ROWS - 1)))
-    return false;
-
-  if (c > 127)
-    c %= 128;
-
-  for (i = 0; i < 8; i++)
-    m_videoRam[row][col * 8 + i] = font8x8_basic[c * 8 + i];
-
-  return true;
-  */
-
-  return MBED_LCD_WriteCharXY(c, col * 8, row * 8);
-}
-
-/**
- * Writes 8x8 character at position - counted in "pixels"
- * Return false if coordinates are outside working area
- */
-bool MBED_LCD_WriteCharXY(char c, uint8_t x, uint8_t y)
-{
-  if ((x >= _MBED_LCD_COLUMNS) || (y >= _MBED_LCD_ROWS))
-    return false;
-
-  if (c > 127)
-    c %= 128;
-
-  for (int i = 0; i < 8; i++)
-  {
-    uint8_t b = font8x8_basic[c * 8 + i];
-
-    for (int j = 0; j < 8; j++)
-    {
-      MBED_LCD_PutPixel(x + i, y + j, b & 0x01);    // LSB first
-      b >>= 1;
-    }
-  }
-
-  return true;
-}
-
-/**
- * Writes string of 8x8 character at position
- * Return false if coordinates of first chracter are outside working area
- * TODO chceking max. length on line
- */
-bool MBED_LCD_WriteStringCR(char *cp, uint8_t col, uint8_t row)
-{
-  if ((col > _MBED_LCD_COLUMNS / 8) || (row > (_MBED_LCD_LINES - 1)))
-    return false;
-
-  for (; *cp; cp++)
-  {
-    MBED_LCD_WriteCharCR(*cp, col, row);
-    col++;
-  }
-
-  return true;
-}
-
-/**
- * Writes string of 8x8 character at position - entered in pixels
- * Return false if coordinates of first chracter are outside working area
- * TODO chceking max. length on line
- */
-bool MBED_LCD_WriteStringXY(char *cp, uint8_t x, uint8_t y)
-{
-  if ((x >= _MBED_LCD_COLUMNS) || (y >= _MBED_LCD_ROWS))
-    return false;
-
-  for (; *cp; cp++)
-  {
-    MBED_LCD_WriteCharXY(*cp, x, y);
-    x += 8;
-  }
-
-  return true;
-}
-
-/**
- * Puts pixel with color black = 1, background = 0
- * TODO check valied coordinates
- */
-void MBED_LCD_PutPixel(uint8_t x, uint8_t y, bool black)
-{
-  //TODO check x < 128 and y < 32
-  if (black)
-    m_videoRam[y / 8][x] |= 1 << (y % 8);
-  else
-    m_videoRam[y / 8][x] &= ~(1 << (y % 8));
-}
-
-/**
- * Draw line with color black = 1, background = 0
- * Coordinates x,y of start point a x,y of end point
- * Bresenham algorithm used (see rosetacode.org)
- * TODO check valied coordinates
- */
-void MBED_LCD_DrawLine(int x0, int y0, int x1, int y1, bool color)
-{
-  int dx = (x0 < x1) ? (x1 - x0) : (x0 - x1), sx = (x0 < x1) ? 1 : -1;
-  int dy = (y0 < y1) ? (y1 - y0) : (y0 - y1), sy = (y0 < y1) ? 1 : -1;
-  int err = ((dx > dy) ? dx : -dy) / 2, e2;
-
-  for (; ; )
-  {
-    if ((x0 == x1) && (y0 == y1))
-      break;
-
-    MBED_LCD_PutPixel((uint8_t)x0, (uint8_t)y0, color);
-
-    e2 = err;
-    if (e2 > -dx)
-    {
-      err -= dy; x0 += sx;
-    }
-
-    if (e2 < dy)
-    {
-      err += dx; y0 += sy;
-    }
-  }
-}
-
-/**
- * Draw lines as rectangle with color black = 1, background = 0
- * TODO check valied coordinates
- */
-void MBED_LCD_DrawRect(int x, int y, int w, int h, bool color)
-{
-  MBED_LCD_DrawLine(x, y, x + w, y, color);
-  MBED_LCD_DrawLine(x + w, y, x + w, y + h, color);
-  MBED_LCD_DrawLine(x + w, y + h, x, y + h, color);
-  MBED_LCD_DrawLine(x, y + h, x, y, color);
-}
-
-/**
- * Draw lines as filled rectangle with color black = 1, background = 0
- * TODO check valied coordinates
- */
-void MBED_LCD_FillRect(int x, int y, int w, int h, bool color)
-{
-  int ww = w, xx = x;
-
-  for(; h; h--)
-  {
-    x = xx;
-
-    for(w = ww; w; w--)
-    {
-      MBED_LCD_PutPixel(x, y, color);
-      x++;
-    }
-
-    y++;
-  }
-}
-
-/**
- * Draw circle with color black = 1, background = 0
- * Algorithm see rosetacode.org
- * Checks valied coordinates for clipping at display margins
- */
-void MBED_LCD_DrawCircle(int centerX, int centerY, int radius, bool colorSet)
-{
-  int d = (5 - radius * 4) / 4;
-  int x = 0;
-  int y = radius;
-
-  do
-  {
-    // ensure index is in range before setting (depends on your image implementation)
-    // in this case we check if the pixel location is within the bounds of the image before setting the pixel
-    if (((centerX + x) >= 0) && ((centerX + x) <= (_MBED_LCD_COLUMNS - 1)) && ((centerY + y) >= 0) && ((centerY + y) <= (_MBED_LCD_ROWS - 1))) MBED_LCD_PutPixel(centerX + x, centerY + y, colorSet);
-    if (((centerX + x) >= 0) && ((centerX + x) <= (_MBED_LCD_COLUMNS - 1)) && ((centerY - y) >= 0) && ((centerY - y) <= (_MBED_LCD_ROWS - 1))) MBED_LCD_PutPixel(centerX + x, centerY - y, colorSet);
-    if (((centerX - x) >= 0) && ((centerX - x) <= (_MBED_LCD_COLUMNS - 1)) && ((centerY + y) >= 0) && ((centerY + y) <= (_MBED_LCD_ROWS - 1))) MBED_LCD_PutPixel(centerX - x, centerY + y, colorSet);
-    if (((centerX - x) >= 0) && ((centerX - x) <= (_MBED_LCD_COLUMNS - 1)) && ((centerY - y) >= 0) && ((centerY - y) <= (_MBED_LCD_ROWS - 1))) MBED_LCD_PutPixel(centerX - x, centerY - y, colorSet);
-    if (((centerX + y) >= 0) && ((centerX + y) <= (_MBED_LCD_COLUMNS - 1)) && ((centerY + x) >= 0) && ((centerY + x) <= (_MBED_LCD_ROWS - 1))) MBED_LCD_PutPixel(centerX + y, centerY + x, colorSet);
-    if (((centerX + y) >= 0) && ((centerX + y) <= (_MBED_LCD_COLUMNS - 1)) && ((centerY - x) >= 0) && ((centerY - x) <= (_MBED_LCD_ROWS - 1))) MBED_LCD_PutPixel(centerX + y, centerY - x, colorSet);
-    if (((centerX - y) >= 0) && ((centerX - y) <= (_MBED_LCD_COLUMNS - 1)) && ((centerY + x) >= 0) && ((centerY + x) <= (_MBED_LCD_ROWS - 1))) MBED_LCD_PutPixel(centerX - y, centerY + x, colorSet);
-    if (((centerX - y) >= 0) && ((centerX - y) <= (_MBED_LCD_COLUMNS - 1)) && ((centerY - x) >= 0) && ((centerY - x) <= (_MBED_LCD_ROWS - 1))) MBED_LCD_PutPixel(centerX - y, centerY - x, colorSet);
-    if (d < 0)
-    {
-      d += 2 * x + 1;
-    }
-    else
-    {
-      d += 2 * (x - y) + 1;
-      y--;
-    }
-    x++;
-  } while (x <= y);
-}
-
-/**
- * Draw lines as filled circle with color black = 1, background = 0
- * TODO check valied coordinates
- */
-void MBED_LCD_FillCircle(int x0, int y0, int radius, bool color)
-{
-  int f = 1 - radius;
-  int ddF_x = 0;
-  int ddF_y = -2 * (int)radius;
-  int x = 0;
-  int y = (int)radius;
-  int t1, t2;
-
-  MBED_LCD_PutPixel(x0, y0 + radius, color);
-  t1 = y0 - radius;
-  MBED_LCD_PutPixel(x0, (t1 > 0) ? t1 : 0, color);
-  t1 = x0 - radius;
-  MBED_LCD_DrawLine(x0 + radius, y0, (t1 > 0) ? t1 : 0, y0, color);
-
-  while(x < y)
-  {
-    if(f >= 0)
-    {
-        y--;
-        ddF_y += 2;
-        f += ddF_y;
-    }
-    x++;
-    ddF_x += 2;
-    f += ddF_x + 1;
-
-    t1 = x0 - x;
-    t2 = y0 - y;
-    MBED_LCD_DrawLine((t1 > 0) ? t1 : 0, y0 + y, x0 + x, y0 + y, color);
-    MBED_LCD_DrawLine((t1 > 0) ? t1 : 0, (t2 > 0) ? t2 : 0, x0 + x, (t2 > 0) ? t2 : 0, color);
-    t1 = x0 - y;
-    t2 = y0 - x;
-    MBED_LCD_DrawLine((t1 > 0) ? t1 : 0, y0 + x, x0 + y, y0 + x, color);
-    MBED_LCD_DrawLine((t1 > 0) ? t1 : 0, (t2 > 0) ? t2 : 0, x0 + y, (t2 > 0) ? t2 : 0, color);
-  }
-}
-
-/**
- * Draw binary sprite to position, data is array of vertical 8-bit values, LSB on top
- * parameter rows = 1-8 used bits, tested on 8
- * color - 1 = fore, non-active pixels aren't filled, use "clear box" before placing
- */
-void MBED_LCD_DrawSpriteMono8(int x, int y, uint8_t *data, int rows, bool color)
-{
-  // use it outside this function ...  DISP_FillRect(x, y, 8, rows, foreColor);
-  if (data == NULL)
-    return;
-
-  for (int r = 0; r < rows; r++)
-  {
-    uint8_t m = 0x80;
-    for (int c = 0; c < 8; c++)
-    {
-      if (data[r] & m)
-        MBED_LCD_PutPixel(x + c, y + r, color);
-
-      m >>= 1;
-    }
-  }
-}
-
-/**
- * Area for refresh - manually or via Timer+DMA
- */
-
-static volatile int _refreshDMAStage = -1;
-
-#ifdef USE_DMA_REFRESH
-uint8_t m_sendBuffer[_MBED_LCD_LINES * _MBED_LCD_COLUMNS];
-#endif
-/**
- * Copying content of videoRAM to LCD controller, based on SPI bulk transfer
- *
- * Duration ca 1.8ms without DMA when closk HSI 16MHz
- * 700us
- */
-bool MBED_LCD_VideoRam2LCD(void)
-{
-  if (_refreshInProgress)
-    return false;
-
-  _refreshInProgress = true;
-#ifdef USE_DMA_REFRESH
-  DMA2_Stream3->CR &= ~DMA_SxCR_EN;
-
-  // Writing 1 to these bits clears the corresponding flags in the DMA_LISR register
-  DMA2->LIFCR = (DMA_LIFCR_CTEIF3 | DMA_LIFCR_CHTIF3 | DMA_LIFCR_CTCIF3 | DMA_LIFCR_CDMEIF3);
-
-  DMA2_Stream3->CR = 0
-     | DMA_SxCR_CHSEL_0 | DMA_SxCR_CHSEL_1  // 011 = channel 3 in stream 3
-     | DMA_SxCR_DIR_1  // 10 = mem to mem = DMA_SxPAR to DMA_SxM0AR
-     | DMA_SxCR_MINC
-     | DMA_SxCR_PINC
-     | DMA_SxCR_TCIE   // irq "complete" fire          DMA_CCR3_MINC
-     ;
-
-  DMA2_Stream3->PAR = (uint32_t)m_videoRam;             // SRC  ... ! 2-dim array
-  DMA2_Stream3->M0AR = (uint32_t)m_sendBuffer;          // DEST ... ! linear array, same size
-
-  DMA2_Stream3->NDTR = _MBED_LCD_LINES * _MBED_LCD_COLUMNS;
-
-  _refreshDMAStage = -1;                                 // start stage: MEM
-  DMA2_Stream3->CR |= DMA_SxCR_EN;                      // go copying
-#else
-  for (uint8_t r = 0; r < _MBED_LCD_LINES; r++)
-  {
-    MBED_LCD_set_page(r);
-    MBED_LCD_set_start_line(0);
-
-#if 1
-    MBED_LCD_sendData(m_videoRam[r], _MBED_LCD_COLUMNS); // block operation
-#else
-    for(uint8_t x = 0; x < _MBED_LCD_COLUMNS; x++)
-      MBED_LCD_send(m_videoRam[r * _MBED_LCD_COLUMNS + x], 1);
-#endif
-  }
-
-  _refreshInProgress = false;
-#endif
-
-  return true;
-}
-
-#ifdef USE_DMA_REFRESH
-void DMA2_Stream3_IRQHandler(void)
-{
-  if (DMA2->LISR & DMA_LISR_TCIF3)
-  {
-    DMA2->LIFCR = DMA_LIFCR_CTCIF3;   // only write 1 available
-
-    if (_refreshDMAStage >= 0)        // not for M2M transfer, which is -1
-    {
-      while(_MBED_LCD_SPI->SR & SPI_SR_BSY)    // while sending is not finished
-        ;                                      // (see. Figure 205. Transmission using DMA - pg.572/836 RM F411)
-
-      BB_REG(_MBED_LCD_PIN_CSN_PORT->ODR, _MBED_LCD_PIN_CSN_PIN) = 1;    // to inactive CS
-    }
-
-    // everytime is needed to clear all including errors, sometimes was set FEIFx ??
-    DMA2->LIFCR = (DMA_LIFCR_CTEIF3 | DMA_LIFCR_CHTIF3 | DMA_LIFCR_CTCIF3 | DMA_LIFCR_CDMEIF3);
-
-    _refreshDMAStage++;
-    if (_refreshDMAStage >= _MBED_LCD_LINES)
-    {
-      DMA2_Stream3->CR &= ~(DMA_SxCR_EN | DMA_SxCR_TCIE);   // stop and disable irq
-
-      _MBED_LCD_SPI->CR2 &= ~SPI_CR2_TXDMAEN;
-      _refreshInProgress = false;
-    }
-    else
-    {
-      DMA2_Stream3->CR &= ~DMA_SxCR_EN;
-
-      _MBED_LCD_SPI->CR2 &= ~SPI_CR2_TXDMAEN;
-
-      MBED_LCD_set_page(_refreshDMAStage);
-      MBED_LCD_set_start_line(0);
-
-      DMA2_Stream3->CR = 0
-        | DMA_SxCR_CHSEL_0 | DMA_SxCR_CHSEL_1  // 011 = channel 3 in stream 3
-        | DMA_SxCR_DIR_0  // 01 = mem to peripheral = DMA_SxM0AR to DMA_SxPAR
-        | DMA_SxCR_MINC
-        | DMA_SxCR_TCIE   // irq "complete" fire          DMA_CCR3_MINC
-        ;
-
-      DMA2_Stream3->PAR = (uint32_t)&(SPI1->DR);      // DEST
-      DMA2_Stream3->M0AR = (uint32_t)&(m_sendBuffer[_refreshDMAStage * _MBED_LCD_COLUMNS]);// SRC
-
-      DMA2_Stream3->NDTR = _MBED_LCD_COLUMNS;
-
-      _MBED_LCD_SPI->CR2 |= SPI_CR2_TXDMAEN;
-
-      BB_REG(_MBED_LCD_PIN_A0_PORT->ODR, _MBED_LCD_PIN_A0_PIN) = 1;      // data transfer
-      BB_REG(_MBED_LCD_PIN_CSN_PORT->ODR, _MBED_LCD_PIN_CSN_PIN) = 0;    // to active CS
-
-      DMA2_Stream3->CR |= DMA_SxCR_EN;        // go
-    }
-  }
-}
-#endif
-
-#ifdef REFRESH_TIMER
-#if (REFRESH_TIMER == 4)
-void TIM4_IRQHandler(void)
-{
-  TIM4->SR = ~TIM_SR_UIF;  // see RM 15.4.5
-
-  MBED_LCD_VideoRam2LCD();
-}
-//#elif
-#else
-//TODO  reagovat na to, ze to chybi
-#error Invalid REFRESH_TIMER settings
-#endif
-#endif
+#include "mbed_shield_lcd.h"
+#include "mbed_shield_lcd_port.h"
+#include <string.h>
+
+#ifndef NULL                // maybe required for "invalid value"
+#define NULL  ((void *)0)
+#endif
+
+#ifdef MBED_LCD_BAND_MODE
+#if defined(USE_DMA_REFRESH) || defined(MBED_LCD_DOUBLE_BUFFER)
+#error MBED_LCD_BAND_MODE renders pages just before sending, only with manual refresh and single buffer
+#endif
+#ifdef MBED_LCD_OVERLAY
+#error MBED_LCD_OVERLAY is combined with Video RAM while sending, not available in MBED_LCD_BAND_MODE
+#endif
+#endif
+
+#ifdef MBED_LCD_HOST
+/**
+ * Host build - transport goes to ST7565 emulator (mbed_shield_lcd_host.c)
+ * With USE_DMA_REFRESH refresh timer and DMA are emulated there too, interrupts run from MBED_LCD_HostRun()
+ */
+#ifdef USE_DMA_REFRESH
+#define _MBED_LCD_TIM_IRQHandler  MBED_LCD_HostTimerIRQHandler
+#define _MBED_LCD_TIMER_PEND()    MBED_LCD_HostTimerPend()
+#define _MBED_LCD_TIMER_START()   MBED_LCD_HostTimerRun(true)
+#define _MBED_LCD_TIMER_RUN()     MBED_LCD_HostTimerRun(true)
+#define _MBED_LCD_TIMER_STOP()    MBED_LCD_HostTimerRun(false)
+#define _MBED_LCD_TIMER_ACK()     ((void)0)
+#endif
+#else
+/**
+ * Include common core function, must contain setGPIO, setAF, GPIOWrite
+ */
+#include "stm_core.h"
+#endif
+
+/**
+ * Board configuration (SPI, pins, DMA, timer), checked also in host build
+ */
+#include "mbed_shield_lcd_config.h"
+
+#ifndef MBED_LCD_HOST
+#ifndef BB_REG
+#define BB_REG(reg, bit) (*(uint32_t *)(PERIPH_BB_BASE + ((uint32_t)(&(reg)) - PERIPH_BASE) * 32 + 4 * (bit)))
+#define BB_RAM(adr, bit) (*(uint32_t *)(SRAM_BB_BASE + ((uint32_t)(adr) - SRAM_BASE) * 32 + 4 * (bit)))
+#endif
+
+/**
+ * Global settings - enable DMA, nable/set timer for auto-refresh
+ */
+#ifndef USE_DMA_REFRESH
+#warning DMA auto refresh is not used. Do not forget to call MBED_LCD_VideoRam2LCD() after changing the frame-buffer content
+#endif
+
+#define _MBED_LCD_CAT(a, b)         _MBED_LCD_CAT_(a, b)
+#define _MBED_LCD_CAT_(a, b)        a##b
+#define _MBED_LCD_CAT3(a, b, c)     _MBED_LCD_CAT3_(a, b, c)
+#define _MBED_LCD_CAT3_(a, b, c)    a##b##c
+
+#ifdef USE_DMA_REFRESH
+/**
+ * Refresh timer, see REFRESH_TIMER
+ */
+#define _MBED_LCD_TIM             _MBED_LCD_CAT(TIM, REFRESH_TIMER)
+#define _MBED_LCD_TIM_IRQn        _MBED_LCD_CAT3(TIM, REFRESH_TIMER, _IRQn)
+#define _MBED_LCD_TIM_IRQHandler  _MBED_LCD_CAT3(TIM, REFRESH_TIMER, _IRQHandler)
+#define _MBED_LCD_TIM_RCC_EN      _MBED_LCD_CAT3(RCC_APB1ENR_TIM, REFRESH_TIMER, EN)
+#define _MBED_LCD_TIM_RCC_RST     _MBED_LCD_CAT3(RCC_APB1RSTR_TIM, REFRESH_TIMER, RST)
+
+#define _MBED_LCD_TIMER_PEND()    NVIC_SetPendingIRQ(_MBED_LCD_TIM_IRQn)                 ///< Tick now
+#define _MBED_LCD_TIMER_START()   (_MBED_LCD_TIM->CNT = 0, _MBED_LCD_TIM->CR1 |= TIM_CR1_CEN) ///< First tick after one period
+#define _MBED_LCD_TIMER_RUN()     (_MBED_LCD_TIM->CR1 |= TIM_CR1_CEN)                    ///< Keep counting
+#define _MBED_LCD_TIMER_STOP()    (_MBED_LCD_TIM->CR1 &= ~TIM_CR1_CEN)
+#define _MBED_LCD_TIMER_ACK()     (_MBED_LCD_TIM->SR = ~TIM_SR_UIF)                      ///< Clear update flag, see RM 15.4.5
+
+/**
+ * Interrupt handler of RX stream of display 0 (shield: DMA2_Stream0_IRQHandler)
+ */
+#define _MBED_LCD_DMA_RX_IRQHandler   _MBED_LCD_DMA_IRQ_NAME(_MBED_LCD_CAT3(_MBED_LCD_SPI, MBED_LCD_CFG_SPI, _DMA), MBED_LCD_CFG_DMA_RX_STREAM)
+#define _MBED_LCD_DMA_IRQ_NAME(dma, n)    _MBED_LCD_DMA_IRQ_NAME_(dma, n)
+#define _MBED_LCD_DMA_IRQ_NAME_(dma, n)   DMA##dma##_Stream##n##_IRQHandler
+#endif
+
+/**
+ * Hardware of each display - display 0 is the board from MBED_LCD_CFG_xxx, for next displays must be defined
+ * globally MBED_LCD_HW1 .. MBED_LCD_HW3 (see MBED_LCD_BOARD()) and
+ * MBED_LCD_HW1_DMA_IRQHandler .. (name of interrupt handler of its RX stream, with USE_DMA_REFRESH)
+ */
+typedef struct
+{
+  SPI_TypeDef *spi;
+  volatile uint32_t *spiRccEnr;                       ///< APBx clock enable of SPI
+  volatile uint32_t *spiRccRstr;                      ///< APBx reset of SPI
+  uint32_t spiRccBit;                                 ///< Same bit in both registers
+  busClock spiBus;                                    ///< Clock of SPI for baud rate
+  uint8_t spiAF;                                      ///< Alternate function of SCK and MOSI
+  GPIO_TypeDef *sckPort;
+  uint8_t sckPin;
+  GPIO_TypeDef *mosiPort;
+  uint8_t mosiPin;
+  GPIO_TypeDef *rstnPort;
+  uint8_t rstnPin;
+  GPIO_TypeDef *csnPort;
+  uint8_t csnPin;
+  GPIO_TypeDef *a0Port;
+  uint8_t a0Pin;
+#ifdef USE_DMA_REFRESH
+  DMA_TypeDef *dma;                                   ///< DMA1 or DMA2 with SPI requests
+  uint32_t dmaRccBit;                                 ///< AHB1 clock enable and reset of DMA
+  uint8_t txStream;                                   ///< Stream 0 .. 7
+  uint8_t rxStream;
+  uint8_t channel;                                    ///< Channel of both streams
+  IRQn_Type rxIRQn;
+#endif
+} _MBED_LCD_Hw_t;
+
+static const _MBED_LCD_Hw_t m_hw[MBED_LCD_INSTANCES] =
+{
+  MBED_LCD_BOARD(MBED_LCD_CFG_SPI, MBED_LCD_CFG_SCK_PORT, MBED_LCD_CFG_SCK_PIN, MBED_LCD_CFG_MOSI_PORT, MBED_LCD_CFG_MOSI_PIN,
+      MBED_LCD_CFG_RSTN_PORT, MBED_LCD_CFG_RSTN_PIN, MBED_LCD_CFG_CSN_PORT, MBED_LCD_CFG_CSN_PIN,
+      MBED_LCD_CFG_A0_PORT, MBED_LCD_CFG_A0_PIN, MBED_LCD_CFG_DMA_TX_STREAM, MBED_LCD_CFG_DMA_RX_STREAM),
+#if (MBED_LCD_INSTANCES > 1)
+  MBED_LCD_HW1,
+#endif
+#if (MBED_LCD_INSTANCES > 2)
+  MBED_LCD_HW2,
+#endif
+#if (MBED_LCD_INSTANCES > 3)
+  MBED_LCD_HW3,
+#endif
+};
+
+#if (MBED_LCD_INSTANCES > 1)
+#define _MBED_LCD_HW(port)    (&m_hw[port])
+#else
+#define _MBED_LCD_HW(port)    ((void)(port), &m_hw[0])      ///< Constant, single display compiles to fixed registers
+#endif
+
+/**
+ * Registers of DMA stream n (0 .. 7) - stream, interrupt status and clear, position of its flags
+ * Without conditions, also for more displays (stream from table)
+ */
+#define _MBED_LCD_DMA_STREAM(dma, n)  ((DMA_Stream_TypeDef *)((uint32_t)(dma) + 0x10 + 0x18 * (n)))
+#define _MBED_LCD_DMA_ISR(dma, n)     ((&(dma)->LISR)[(n) >> 2])      ///< LISR or HISR
+#define _MBED_LCD_DMA_IFCR(dma, n)    ((&(dma)->LIFCR)[(n) >> 2])     ///< LIFCR or HIFCR
+#define _MBED_LCD_DMA_SHIFT(n)        (((n) & 3) * 6 + ((n) & 2) * 2)   ///< 0, 6, 16, 22
+
+/**
+ * Differencies between platforms
+ */
+#ifdef _MBED_LCD_STM32F4
+#define SPI_IS_BUSY(SPIx) (((SPIx)->SR & (SPI_SR_TXE | SPI_SR_RXNE)) == 0 || ((SPIx)->SR & SPI_SR_BSY))
+#else
+#define SPI_IS_BUSY(SPIx) (((SPIx)->SR & SPI_SR_TXE) == 0 || ((SPIx)->SR & SPI_SR_BSY))
+#endif
+#endif  // MBED_LCD_HOST
+
+/**
+ * Drawing settings, can be set globally
+ */
+#ifndef MBED_LCD_CLIP_DEPTH
+#define MBED_LCD_CLIP_DEPTH   4           ///< Count of clip rectangles saved by MBED_LCD_PushClip()
+#endif
+#ifndef MBED_LCD_BAND_LIST
+#define MBED_LCD_BAND_LIST    256         ///< Bytes of display list in MBED_LCD_BAND_MODE
+#endif
+#ifndef MBED_LCD_OVERLAY_ITEMS
+#define MBED_LCD_OVERLAY_ITEMS  4         ///< Overlay items of each display, with MBED_LCD_OVERLAY
+#endif
+#if (MBED_LCD_OVERLAY_ITEMS < 1) || (MBED_LCD_OVERLAY_ITEMS > 255)
+#error Invalid MBED_LCD_OVERLAY_ITEMS settings (1 .. 255)
+#endif
+#ifndef MBED_LCD_GLYPH_CACHE_WIDTH
+#define MBED_LCD_GLYPH_CACHE_WIDTH  8     ///< Widest glyph kept pre-shifted, with MBED_LCD_GLYPH_CACHE (bytes of RAM)
+#endif
+#if defined(MBED_LCD_GLYPH_CACHE) && ((MBED_LCD_GLYPH_CACHE < 128) || (MBED_LCD_GLYPH_CACHE_WIDTH < 1) || (MBED_LCD_GLYPH_CACHE_WIDTH > 255))
+#error Invalid MBED_LCD_GLYPH_CACHE settings (min. 128 bytes, MBED_LCD_GLYPH_CACHE_WIDTH 1 .. 255)
+#endif
+#ifndef MBED_LCD_CONSOLE_TAB
+#define MBED_LCD_CONSOLE_TAB  4           ///< Tab stops of console, in characters
+#endif
+
+/**
+ * Physical dimensions of LCD, controler can support 132x64 max
+ */
+#define _MBED_LCD_COLUMNS   128           ///< Horizontal pixels count
+#define _MBED_LCD_ROWS      32            ///< Vertical pixels couns
+#define _MBED_LCD_LINES     (_MBED_LCD_ROWS / 8)              ///< Count of 8x8 chars horizontaly
+#define _MBED_LCD_CHAR_PER_LINE     (_MBED_LCD_COLUMNS / 8)   ///< Count of 8x8 chars verticaly
+#define _MBED_LCD_RAM_PAGES 8             ///< Pages of controller RAM (64 rows), ring for hardware scroll
+
+/**
+ * Returns count of pixel horizontaly
+ */
+inline uint8_t MBED_LCD_GetColumns(void)
+{
+  return _MBED_LCD_COLUMNS;
+}
+
+/**
+ * Return count of pixel verticaly
+ */
+inline uint8_t MBED_LCD_GetRows(void)
+{
+  return _MBED_LCD_ROWS;
+}
+
+/**
+ * Returns count of text rows with default fonr 8x8
+ */
+inline uint8_t MBED_LCD_GetLines(void)
+{
+  return _MBED_LCD_LINES;
+}
+
+/**
+ * Returns count of text columns with default fonr 8x8
+ */
+inline uint8_t MBED_LCD_GetCharPerLine(void)
+{
+  return _MBED_LCD_CHAR_PER_LINE;
+}
+
+/**
+ * Refresh statistics - counters and durations in ticks of clock (CPU cycles from DWT on target)
+ */
+typedef struct
+{
+  uint32_t count;
+  uint32_t min;
+  uint32_t max;
+  uint64_t sum;
+} _MBED_LCD_TimeAcc_t;
+
+/**
+ * Clip rectangle - all drawing functions write only inside it, default is whole display
+ * Half-open ranges x0 <= x < x1, y0 <= y < y1, always inside display (may be empty)
+ */
+typedef struct
+{
+  uint8_t x0, y0;
+  uint8_t x1, y1;
+} _MBED_LCD_Clip_t;
+
+#ifdef MBED_LCD_OVERLAY
+/**
+ * Overlay item - solid rectangle or bitmap combined with front buffer only while sending to LCD
+ */
+typedef struct
+{
+  int16_t x, y;                                       ///< Top left corner, may be outside display
+  int16_t w, h;
+  const MBED_LCD_Bitmap_t *bmp;                       ///< NULL for solid rectangle
+  uint8_t rop;                                        ///< MBED_LCD_Rop_t
+  bool visible;
+} _MBED_LCD_Overlay_t;
+#endif
+
+#ifdef USE_DMA_REFRESH
+/**
+ * Queue of asynchronous commands - filled by main context, sent by interrupts between refresh transfers
+ */
+typedef struct
+{
+  uint8_t cmd[MBED_LCD_CMD_MAX_LEN];
+  uint8_t len;
+  MBED_LCD_Callback_t done;
+} _MBED_LCD_CmdReq_t;
+
+/**
+ * State of SPI transfer - every part (commands with A0 = 0, data with A0 = 1) is one DMA transfer
+ * End of part is signaled by RX DMA "complete", then the last byte is out and A0 can be changed
+ */
+typedef enum
+{
+  _MBED_LCD_SPI_IDLE = 0,
+  _MBED_LCD_SPI_PAGE_CMD,                               ///< Page and column address of refreshDMAStage
+  _MBED_LCD_SPI_PAGE_DATA,                              ///< Changed span of refreshDMAStage
+  _MBED_LCD_SPI_START_LINE,                             ///< Start line after all pages of refresh
+  _MBED_LCD_SPI_ASYNC,                                  ///< Request cmdQueue[cmdTail]
+} _MBED_LCD_SpiState_t;
+
+#endif
+
+/**
+ *  Context of one display - Video RAM, changed areas, refresh and transfer state, statistics
+ *  Video RAM requires LINES * COLUMNS bytes at BSS segment
+ *  With MBED_LCD_DOUBLE_BUFFER drawing goes to back buffer, refresh reads front buffer
+ *  and MBED_LCD_SwapBuffers() exchanges them, otherwise refresh reads videoRam directly (no copy)
+ *  With MBED_LCD_BAND_MODE there is only one page, drawing functions write to it while list is replayed
+ *  Drawing functions access page p only by _MBED_LCD_ROW(p)
+ */
+typedef struct
+{
+#if defined(MBED_LCD_BAND_MODE)
+  uint8_t bandRam[_MBED_LCD_COLUMNS];                 ///< Page rendered now, clip allows only this page
+#elif defined(MBED_LCD_DOUBLE_BUFFER)
+  uint8_t videoRamBuf[2][_MBED_LCD_LINES][_MBED_LCD_COLUMNS];
+  volatile uint8_t back;                              ///< Index of back buffer (drawing), other is front (refresh)
+#else
+  uint8_t videoRam[_MBED_LCD_LINES][_MBED_LCD_COLUMNS];
+#endif
+  volatile bool refreshInProgress;
+  volatile uint8_t drawLock;                          ///< Refresh is not started while locked
+  volatile uint32_t frameSeq;                         ///< Count of frames published by MBED_LCD_EndFrame()
+  volatile uint32_t refreshSeq;                       ///< Last frame included in running refresh
+  volatile uint32_t doneSeq;                          ///< Last frame completely sent to LCD
+  MBED_LCD_Callback_t frameDone;                      ///< Called when doneSeq moves (from interrupt with DMA)
+#ifdef MBED_LCD_DOUBLE_BUFFER
+  uint8_t frameDepth;                                 ///< Nesting of MBED_LCD_BeginFrame()
+#endif
+
+  // Hardware scroll - page j of Video RAM is shown from controller page (head + j) % 8, head * 8 = start line
+  // Scroll moves Video RAM pages up (cheap memmove), the LCD gets only start line and new bottom page
+  uint8_t pageHead;                                   ///< Head of Video RAM (back buffer with double buffer)
+#ifdef MBED_LCD_DOUBLE_BUFFER
+  volatile uint8_t frontHead;                         ///< Head of front buffer, changed by swap
+  uint8_t scrolled;                                   ///< Text lines scrolled in back buffer since last swap
+#endif
+  uint8_t lcdHead;                                    ///< Head set in controller, start line is sent when differs
+  uint8_t refreshHead;                                ///< Head of front buffer for running refresh
+
+  // Changed area of Video RAM - column range [from, to) for each page packed by _MBED_LCD_SPAN(), empty range is from >= to
+  // Pixel must be written before marking, refresh takes snapshot of ranges before reading Video RAM
+  // Mark and snapshot change whole word atomically, so mark from main loop is not lost by refresh in interrupt
+  // With double buffer marks of back buffer are moved to send by swap
+  volatile uint16_t dirty[_MBED_LCD_LINES];
+#ifdef MBED_LCD_DOUBLE_BUFFER
+  volatile uint16_t send[_MBED_LCD_LINES];            ///< Changed area of front buffer, not sent yet
+#endif
+
+#ifdef MBED_LCD_BAND_MODE
+  uint8_t bandList[MBED_LCD_BAND_LIST];               ///< Records [op][length of args][args]
+  uint16_t bandUsed;
+  bool bandOverflow;                                  ///< Some command did not fit to list
+  uint8_t bandBack;                                   ///< Background from MBED_LCD_InitVideoRam()
+  uint8_t bandClipDepth;                              ///< Recorded MBED_LCD_PushClip() calls
+  bool bandChanged;                                   ///< List changed since last refresh
+  bool bandRender;                                    ///< List is replayed, drawing functions draw
+  uint8_t bandFrom[_MBED_LCD_LINES];                  ///< Columns sent in previous frame
+  uint8_t bandTo[_MBED_LCD_LINES];
+#endif
+
+  _MBED_LCD_Clip_t clipStack[MBED_LCD_CLIP_DEPTH];    ///< Saved by MBED_LCD_PushClip(), clip itself is _MBED_LCD_CLIP
+  uint8_t clipDepth;
+  const MBED_LCD_Font_t *font;                        ///< Font of XY text functions, NULL = MBED_LCD_Font8x8
+  uint8_t conCol;                                     ///< Console cursor, in characters
+  uint8_t conRow;
+
+#ifdef MBED_LCD_OVERLAY
+  _MBED_LCD_Overlay_t overlay[MBED_LCD_OVERLAY_ITEMS];
+  uint8_t overlayBuf[_MBED_LCD_COLUMNS];              ///< Span composed with overlay, sent instead of Video RAM
+#endif
+
+  volatile uint32_t sentBytes;                        ///< Count of bytes sent to LCD (commands + data)
+  volatile uint32_t refreshStarted;
+  volatile uint32_t refreshCompleted;
+  volatile uint32_t refreshSkipped;
+  volatile uint32_t refreshNoChange;
+  _MBED_LCD_TimeAcc_t timeRefresh;                    ///< From start of transfer to end of last page
+  _MBED_LCD_TimeAcc_t timeDmaIsr;                     ///< DMA "complete" interrupt (SPI RX)
+  uint32_t refreshStartTime;
+
+#ifdef USE_DMA_REFRESH
+  volatile int refreshDMAStage;                       ///< Page of running refresh
+  uint8_t refreshFrom[_MBED_LCD_LINES];               ///< Snapshot of changed ranges for running refresh
+  uint8_t refreshTo[_MBED_LCD_LINES];
+  _MBED_LCD_CmdReq_t cmdQueue[MBED_LCD_CMD_QUEUE];
+  volatile uint8_t cmdHead;                           ///< Next free slot, written only by main context
+  volatile uint8_t cmdTail;                           ///< Request sent now or next one, written only by interrupt
+  volatile _MBED_LCD_SpiState_t spiState;
+  uint8_t pageCmd[3];                                 ///< Page and column commands for DMA
+  uint8_t lineCmd;                                    ///< Start line command for DMA
+  uint8_t spiDummy;                                   ///< Received bytes go here, only end of RX is used
+#endif
+} _MBED_LCD_Ctx_t;
+
+static _MBED_LCD_Ctx_t m_ctx[MBED_LCD_INSTANCES];       ///< Zero at start (BSS)
+
+/**
+ *  Clip rectangles are not zero at start (whole display), so they are kept out of context
+ *  Limit is whole display, one page in MBED_LCD_BAND_MODE render
+ */
+#define _MBED_LCD_CLIP_FULL   { 0, 0, _MBED_LCD_COLUMNS, _MBED_LCD_ROWS }
+#if (MBED_LCD_INSTANCES == 1)
+#define _MBED_LCD_CLIP_INIT   { _MBED_LCD_CLIP_FULL }
+#elif (MBED_LCD_INSTANCES == 2)
+#define _MBED_LCD_CLIP_INIT   { _MBED_LCD_CLIP_FULL, _MBED_LCD_CLIP_FULL }
+#elif (MBED_LCD_INSTANCES == 3)
+#define _MBED_LCD_CLIP_INIT   { _MBED_LCD_CLIP_FULL, _MBED_LCD_CLIP_FULL, _MBED_LCD_CLIP_FULL }
+#else
+#define _MBED_LCD_CLIP_INIT   { _MBED_LCD_CLIP_FULL, _MBED_LCD_CLIP_FULL, _MBED_LCD_CLIP_FULL, _MBED_LCD_CLIP_FULL }
+#endif
+static _MBED_LCD_Clip_t m_clipOf[MBED_LCD_INSTANCES] = _MBED_LCD_CLIP_INIT;
+static _MBED_LCD_Clip_t m_clipLimitOf[MBED_LCD_INSTANCES] = _MBED_LCD_CLIP_INIT;
+
+/**
+ *  Selected display - public functions work with it, interrupt handlers select their display
+ *  for own duration and restore previous one. Single display has constant index (fixed addresses, no overhead)
+ */
+#if (MBED_LCD_INSTANCES > 1)
+static uint8_t _lcdIndex = 0;
+#define _MBED_LCD_INDEX       _lcdIndex
+#define _MBED_LCD_ENTER(i)    uint8_t _lcdSaved = _lcdIndex; _lcdIndex = (i)
+#define _MBED_LCD_LEAVE()     (_lcdIndex = _lcdSaved)
+#else
+#define _MBED_LCD_INDEX       0
+#define _MBED_LCD_ENTER(i)    ((void)(i))
+#define _MBED_LCD_LEAVE()     ((void)0)
+#endif
+#define _MBED_LCD_CTX         (&m_ctx[_MBED_LCD_INDEX])
+#define _MBED_LCD_CLIP        (m_clipOf[_MBED_LCD_INDEX])
+#define _MBED_LCD_CLIP_LIMIT  (m_clipLimitOf[_MBED_LCD_INDEX])
+
+/**
+ *  Video RAM of context - drawing goes to back buffer (same as front one without MBED_LCD_DOUBLE_BUFFER), refresh sends
+ *  front buffer; _MBED_LCD_ROW() is page of drawing (one page buffer in MBED_LCD_BAND_MODE)
+ */
+#if defined(MBED_LCD_BAND_MODE)
+#define _MBED_LCD_ROW(ctx, p)         ((ctx)->bandRam)
+#else
+#if defined(MBED_LCD_DOUBLE_BUFFER)
+#define _MBED_LCD_VRAM(ctx)           ((ctx)->videoRamBuf[(ctx)->back])
+#define _MBED_LCD_FRONT(ctx)          ((ctx)->videoRamBuf[(ctx)->back ^ 1])
+#else
+#define _MBED_LCD_VRAM(ctx)           ((ctx)->videoRam)
+#define _MBED_LCD_FRONT(ctx)          ((ctx)->videoRam)
+#endif
+#define _MBED_LCD_ROW(ctx, p)         (_MBED_LCD_VRAM(ctx)[p])
+#endif
+
+/**
+ *  Refresh sends front buffer by own changed ranges and head, without MBED_LCD_DOUBLE_BUFFER they are the ones of drawing
+ */
+#ifdef MBED_LCD_DOUBLE_BUFFER
+#define _MBED_LCD_FRONT_HEAD(ctx)     ((ctx)->frontHead)
+#define _MBED_LCD_SEND(ctx)           ((ctx)->send)
+#else
+#define _MBED_LCD_FRONT_HEAD(ctx)     ((ctx)->pageHead)
+#define _MBED_LCD_SEND(ctx)           ((ctx)->dirty)
+#endif
+
+/**
+ *  Column range [from, to) of page in one word - low byte from, high byte to
+ */
+#define _MBED_LCD_SPAN(from, to)      ((uint16_t)((from) | ((to) << 8)))
+#define _MBED_LCD_SPAN_FROM(span)     ((uint8_t)(span))
+#define _MBED_LCD_SPAN_TO(span)       ((uint8_t)((span) >> 8))
+#define _MBED_LCD_SPAN_EMPTY          _MBED_LCD_SPAN(_MBED_LCD_COLUMNS, 0)
+#define _MBED_LCD_SPAN_ALL            _MBED_LCD_SPAN(0, _MBED_LCD_COLUMNS)
+
+static volatile bool _refreshIdle = false;            ///< Refresh timer stopped, nothing to send (common for all displays)
+
+#ifdef MBED_LCD_BAND_MODE
+/**
+ *  Band mode - drawing functions record commands to display list, refresh replays the list for each page
+ *  into bandRam (clip = rows of the page) and sends columns touched in this or previous frame
+ *  Frame starts by MBED_LCD_InitVideoRam(), bitmaps and images are recorded by pointer (must stay valid)
+ */
+typedef enum
+{
+  _MBED_LCD_BAND_PIXEL = 1,
+  _MBED_LCD_BAND_LINE,
+  _MBED_LCD_BAND_RECT,
+  _MBED_LCD_BAND_FILL_RECT,
+  _MBED_LCD_BAND_INVERT_RECT,
+  _MBED_LCD_BAND_CIRCLE,
+  _MBED_LCD_BAND_FILL_CIRCLE,
+  _MBED_LCD_BAND_TEXT,                                  ///< _MBED_LCD_BandText_t + characters up to end of record
+  _MBED_LCD_BAND_BITMAP,
+  _MBED_LCD_BAND_IMAGE,
+  _MBED_LCD_BAND_CLIP_SET,
+  _MBED_LCD_BAND_CLIP_PUSH,
+  _MBED_LCD_BAND_CLIP_POP,
+  _MBED_LCD_BAND_CLIP_RESET,
+} _MBED_LCD_BandOp_t;
+
+typedef struct
+{
+  int16_t a, b, c, d;                                   ///< Coordinates in order of function parameters
+  uint8_t color;
+} _MBED_LCD_BandShape_t;
+
+typedef struct
+{
+  int16_t x, y;
+  uint8_t rop;
+  MBED_LCD_Bitmap_t bmp;
+} _MBED_LCD_BandBitmap_t;
+
+typedef struct
+{
+  int16_t x, page;
+  uint16_t size;
+  const uint8_t *img;
+} _MBED_LCD_BandImage_t;
+
+typedef struct
+{
+  int16_t x, y;
+  const MBED_LCD_Font_t *font;
+} _MBED_LCD_BandText_t;
+
+static void _MBED_LCD_BandPut(uint8_t op, const void *arg, uint8_t len, const char *text, uint8_t textLen)  ///< Append record
+{
+  _MBED_LCD_Ctx_t *ctx = _MBED_LCD_CTX;
+  uint8_t *dst = &ctx->bandList[ctx->bandUsed];
+
+  if (ctx->bandUsed + 2 + len + textLen > MBED_LCD_BAND_LIST)
+  {
+    ctx->bandOverflow = true;
+    return;
+  }
+
+  dst[0] = op;
+  dst[1] = len + textLen;
+  if (len > 0)
+    memcpy(&dst[2], arg, len);
+  if (textLen > 0)
+    memcpy(&dst[2 + len], text, textLen);
+
+  ctx->bandUsed += 2 + dst[1];
+  ctx->bandChanged = true;
+}
+
+static void _MBED_LCD_BandShape(uint8_t op, int a, int b, int c, int d, bool color, const char *text, uint8_t textLen)
+{
+  _MBED_LCD_BandShape_t s;
+
+  s.a = a;
+  s.b = b;
+  s.c = c;
+  s.d = d;
+  s.color = color;
+  _MBED_LCD_BandPut(op, &s, sizeof(s), text, textLen);
+}
+#endif
+
+#ifdef USE_DMA_REFRESH
+static inline void _MBED_LCD_wake_refresh(void)       ///< Start stopped refresh timer, first frame after one period
+{
+  if (_refreshIdle)
+  {
+    _refreshIdle = false;
+    _MBED_LCD_TIMER_START();
+  }
+}
+#else
+#define _MBED_LCD_wake_refresh()    ((void)0)
+#endif
+
+/**
+ * Take ownership of front buffer and SPI for refresh (or swap) - test and set of refreshInProgress in one
+ * exclusive access (LDREX/STREX), interrupts are not disabled. False = refresh runs or other context owns it
+ */
+static inline bool _MBED_LCD_claim_refresh(void)
+{
+  return !__atomic_exchange_n(&_MBED_LCD_CTX->refreshInProgress, true, __ATOMIC_ACQUIRE);
+}
+
+static inline void _MBED_LCD_unclaim_refresh(void)    ///< Release after all reads and writes of front buffer
+{
+  __atomic_store_n(&_MBED_LCD_CTX->refreshInProgress, false, __ATOMIC_RELEASE);
+}
+
+static _MBED_LCD_TimeAcc_t m_timeTimerIsr;            ///< Refresh timer interrupt (common for all displays)
+
+#ifdef MBED_LCD_HOST
+static uint32_t (*m_clock)(void) = NULL;              ///< No timing on host until MBED_LCD_SetClock()
+#else
+static uint32_t _MBED_LCD_dwt_clock(void)
+{
+  return DWT->CYCCNT;
+}
+
+static uint32_t (*m_clock)(void) = _MBED_LCD_dwt_clock;
+#endif
+
+static inline uint32_t _MBED_LCD_Now(void)
+{
+  return (m_clock != NULL) ? m_clock() : 0;
+}
+
+static void _MBED_LCD_TimeAdd(_MBED_LCD_TimeAcc_t *acc, uint32_t ticks)   ///< Add one measured duration
+{
+  if ((acc->count == 0) || (ticks < acc->min))
+    acc->min = ticks;
+  if (ticks > acc->max)
+    acc->max = ticks;
+  acc->sum += ticks;
+  acc->count++;
+}
+
+/**
+ * Profiling counters for benchmarks, only with global symbol MBED_LCD_PROFILE (no code otherwise)
+ */
+#ifdef MBED_LCD_PROFILE
+static MBED_LCD_Profile_t m_profile;
+#define _MBED_LCD_PROF_ADD(item, n)   (m_profile.item += (n))
+#else
+#define _MBED_LCD_PROF_ADD(item, n)   ((void)0)
+#endif
+
+/**
+ * Join columns x0 .. x1-1 to range, compare and exchange (LDREXH/STREXH) repeats when refresh took range meanwhile
+ */
+static inline void _MBED_LCD_SpanJoin(volatile uint16_t *span, uint8_t x0, uint8_t x1)
+{
+  uint16_t old = __atomic_load_n(span, __ATOMIC_RELAXED);
+  uint16_t joined;
+
+  do
+  {
+    uint8_t from = _MBED_LCD_SPAN_FROM(old);
+    uint8_t to = _MBED_LCD_SPAN_TO(old);
+
+    joined = _MBED_LCD_SPAN((x0 < from) ? x0 : from, (x1 > to) ? x1 : to);
+    if (joined == old)                                  // already marked
+      return;
+  } while (!__atomic_compare_exchange_n(span, &old, joined, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
+
+static inline void _MBED_LCD_MarkDirty(uint8_t page, uint8_t x0, uint8_t x1)  ///< Mark columns x0 .. x1-1 at page as changed
+{
+  _MBED_LCD_PROF_ADD(fbBytes, x1 - x0);                 // every write to Video RAM is marked
+  _MBED_LCD_SpanJoin(&_MBED_LCD_CTX->dirty[page], x0, x1);
+
+#ifndef MBED_LCD_DOUBLE_BUFFER
+  _MBED_LCD_wake_refresh();                             // after marking, timer can stop just before it
+#endif
+}
+
+static inline void _MBED_LCD_MarkAllDirty(void)       ///< Whole Video RAM must be sent
+{
+  _MBED_LCD_Ctx_t *ctx = _MBED_LCD_CTX;
+
+  _MBED_LCD_PROF_ADD(fbBytes, _MBED_LCD_LINES * _MBED_LCD_COLUMNS);
+  for(int r = 0; r < _MBED_LCD_LINES; r++)
+    __atomic_store_n(&ctx->dirty[r], _MBED_LCD_SPAN_ALL, __ATOMIC_RELEASE);
+
+#ifndef MBED_LCD_DOUBLE_BUFFER
+  _MBED_LCD_wake_refresh();
+#endif
+}
+
+#ifdef MBED_LCD_OVERLAY
+/**
+ * Mark columns of visible overlay item to be sent - Video RAM is not changed, only front buffer is resent
+ * With allPages all pages of its columns (content moved by hardware scroll)
+ */
+static void _MBED_LCD_OverlayMark(const _MBED_LCD_Overlay_t *o, bool allPages)
+{
+  _MBED_LCD_Ctx_t *ctx = _MBED_LCD_CTX;
+  int c0 = (o->x > 0) ? o->x : 0;
+  int c1 = ((o->x + o->w) < _MBED_LCD_COLUMNS) ? (o->x + o->w) : _MBED_LCD_COLUMNS;
+  int p0 = (o->y > 0) ? (o->y / 8) : 0;
+  int p1 = (o->y + o->h + 7) / 8;
+
+  if (allPages)
+  {
+    p0 = 0;
+    p1 = _MBED_LCD_LINES;
+  }
+  if (p1 > _MBED_LCD_LINES)
+    p1 = _MBED_LCD_LINES;
+
+  if (!o->visible || (c0 >= c1) || (p0 >= p1))
+    return;
+
+  for (int p = p0; p < p1; p++)
+    _MBED_LCD_SpanJoin(&_MBED_LCD_SEND(ctx)[p], c0, c1);
+
+  _MBED_LCD_wake_refresh();
+}
+#endif
+
+/**
+ * Private funcions
+ */
+#ifndef MBED_LCD_HOST
+/**
+ * Target transport - SPI with A0, CS and RST signals at GPIO, see mbed_shield_lcd_port.h
+ * Block is streamed under one CS - next byte is written to DR as soon as TXE is set (DR moved to shift register),
+ * so bytes follow without gap. A0 and CS are changed only after the last bit is out (controller latches A0 with it)
+ */
+static void _MBED_LCD_PortStream(const _MBED_LCD_Hw_t *hw, const uint8_t *val, uint16_t len, bool a0)
+{
+  BB_REG(hw->a0Port->ODR, hw->a0Pin) = a0 ? 1 : 0;
+  BB_REG(hw->csnPort->ODR, hw->csnPin) = 0;
+
+  for(; len; len--)
+  {
+    while(!(hw->spi->SR & SPI_SR_TXE))                // one byte in DR, one in shift register
+      ;
+    hw->spi->DR = *val++;
+  }
+
+  while(SPI_IS_BUSY(hw->spi))                         // waiting is different fo F4xx and another Fxxx
+    ;                                                 // blocking waiting
+
+  BB_REG(hw->csnPort->ODR, hw->csnPin) = 1;
+}
+
+void MBED_LCD_PortSend(uint8_t port, uint8_t val, bool a0)  ///< Write single value to LCD - using SPI, A0 selects CMD = 0, DATA = 1
+{
+  _MBED_LCD_PortStream(_MBED_LCD_HW(port), &val, 1, a0);
+}
+
+void MBED_LCD_PortSendCommands(uint8_t port, const uint8_t *cmds, uint16_t len)  ///< Write sequence of commands, one CS
+{
+  _MBED_LCD_PortStream(_MBED_LCD_HW(port), cmds, len, false);
+}
+
+void MBED_LCD_PortSendData(uint8_t port, const uint8_t *val, uint16_t len)  ///< Write block of data, pointer to start and length
+{
+  _MBED_LCD_PortStream(_MBED_LCD_HW(port), val, len, true);
+}
+
+bool MBED_LCD_PortReset(uint8_t port)                   ///< Perform reset sequence
+{
+  const _MBED_LCD_Hw_t *hw = _MBED_LCD_HW(port);
+  uint16_t w, x = 0;
+
+  BB_REG(hw->a0Port->ODR, hw->a0Pin) = 0;
+  BB_REG(hw->rstnPort->ODR, hw->rstnPin) = 0;
+
+  for(w = 0; w < 10000; w++)
+    x++;                                                // Dummy increment prevents optimalisation
+
+  BB_REG(hw->rstnPort->ODR, hw->rstnPin) = 1;
+
+  for(w = 0; w < 1000; w++)
+    x++;
+
+  return (x > 0);                                       // Trick to keep vaiable unoptimalised ...
+}
+
+bool MBED_LCD_PortInit(uint8_t port)                    ///< Init SPI, GPIO, ...
+{
+  const _MBED_LCD_Hw_t *hw = _MBED_LCD_HW(port);
+  uint32_t pclk;
+
+  STM_SetPinGPIO(hw->rstnPort, hw->rstnPin, ioPortOutputPP);
+  BB_REG(hw->rstnPort->ODR, hw->rstnPin) = 1;
+  STM_SetPinGPIO(hw->csnPort, hw->csnPin, ioPortOutputPP);
+  BB_REG(hw->csnPort->ODR, hw->csnPin) = 1;
+  STM_SetPinGPIO(hw->a0Port, hw->a0Pin, ioPortOutputPP);
+
+  STM_SetPinGPIO(hw->mosiPort, hw->mosiPin, ioPortAlternatePP);
+  STM_SetPinGPIO(hw->sckPort, hw->sckPin, ioPortAlternatePP);
+#ifdef _MBED_LCD_STM32F4
+  STM_SetAFGPIO(hw->mosiPort, hw->mosiPin, hw->spiAF);            // AFxx, STM32F1 has fixed (or remapped by application) pins
+  STM_SetAFGPIO(hw->sckPort, hw->sckPin, hw->spiAF);
+#endif
+
+  if (!(*hw->spiRccEnr & hw->spiRccBit))
+  {
+    *hw->spiRccEnr |= hw->spiRccBit;
+    *hw->spiRccRstr |= hw->spiRccBit;
+    *hw->spiRccRstr &= ~hw->spiRccBit;
+  }
+  pclk = GetBusClock(hw->spiBus);                      // APB1 or APB2, from board table
+
+  hw->spi->CR1 = 0
+      | SPI_CR1_CPHA | SPI_CR1_CPOL     // polarity from DS
+      | SPI_CR1_SSI | SPI_CR1_SSM       // required for correct function
+      | SPI_CR1_MSTR
+      | (MBED_LCD_SPI_BR(pclk) << 3);   // prescaler, bits 5..3 (F1 and F4)
+  hw->spi->CR2 = 0;
+
+  hw->spi->CR1 |= SPI_CR1_SPE;                   // enable
+
+  return true;
+}
+#endif  // MBED_LCD_HOST
+
+static inline void MBED_LCD_send(uint8_t val, bool a0)        ///< Write single value to LCD, counted
+{
+  _MBED_LCD_CTX->sentBytes++;
+  if (a0)
+    _MBED_LCD_PROF_ADD(spiData, 1);
+  else
+    _MBED_LCD_PROF_ADD(spiCommands, 1);
+  MBED_LCD_PortSend(_MBED_LCD_INDEX, val, a0);
+}
+
+static inline void MBED_LCD_sendData(const uint8_t *val, uint16_t len)  ///< Write block of data to LCD, counted
+{
+  _MBED_LCD_CTX->sentBytes += len;
+  _MBED_LCD_PROF_ADD(spiData, len);
+  MBED_LCD_PortSendData(_MBED_LCD_INDEX, val, len);
+}
+
+static inline void MBED_LCD_sendCommands(const uint8_t *cmds, uint16_t len)  ///< Write commands to LCD under one CS, counted
+{
+  _MBED_LCD_CTX->sentBytes += len;
+  _MBED_LCD_PROF_ADD(spiCommands, len);
+  MBED_LCD_PortSendCommands(_MBED_LCD_INDEX, cmds, len);
+}
+
+#ifndef USE_DMA_REFRESH                                 // DMA refresh sends addresses from _MBED_LCD_spi_next()
+static void MBED_LCD_set_address(uint8_t p, uint8_t x)  ///< Send page and column commands to LCD in one block, info from DS
+{
+  uint8_t cmds[3];
+
+  cmds[0] = 0xB0 | (p & 0x0f);                          // (3) Page address set = Sets the display RAM page address - lower 4 bits
+  cmds[1] = 0x10 | ((x & 0xf0) >> 4);                   // (4) Column address set = upper 4 bits
+  cmds[2] = 0x00 | (x & 0x0f);                          // (4) Column address set = lower 4 bits
+  MBED_LCD_sendCommands(cmds, sizeof(cmds));
+}
+
+#ifndef MBED_LCD_BAND_MODE                              // band mode does not scroll
+static void MBED_LCD_set_start_line(uint8_t line)       ///< Send command to LCD, info from DS
+{
+  MBED_LCD_send(0x40 | (line & 0x3f), 0);               // (2) Display start line set = RAM row shown at top
+}
+#endif
+#endif
+
+#ifndef MBED_LCD_BAND_MODE
+static void _MBED_LCD_ShiftPages(uint8_t (*ram)[_MBED_LCD_COLUMNS], uint8_t lines)  ///< Move pages up, clear bottom
+{
+  if (lines > _MBED_LCD_LINES)
+    lines = _MBED_LCD_LINES;
+
+  memmove(ram[0], ram[lines], (_MBED_LCD_LINES - lines) * _MBED_LCD_COLUMNS);
+  memset(ram[_MBED_LCD_LINES - lines], 0, lines * _MBED_LCD_COLUMNS);
+}
+#endif
+
+static bool _MBED_LCD_init_hw_refresh(void)   // call after LCD init
+{
+#if defined(USE_DMA_REFRESH) && defined(MBED_LCD_HOST)
+  _MBED_LCD_TIMER_START();                              // emulated, ticks run from MBED_LCD_HostRun()
+#elif defined(USE_DMA_REFRESH)
+//  bbUseDMA = false;
+  const _MBED_LCD_Hw_t *hw = _MBED_LCD_HW(_MBED_LCD_INDEX);
+
+  if (!(RCC->AHB1ENR & hw->dmaRccBit))
+  {
+    RCC->AHB1ENR |= hw->dmaRccBit;
+    RCC->AHB1RSTR |= hw->dmaRccBit;                     // same bit in reset register
+    RCC->AHB1RSTR &= ~hw->dmaRccBit;
+  }
+
+  NVIC_EnableIRQ(hw->rxIRQn);                           // SPI RX "complete" drives transfer
+
+  uint32_t apb = GetTimerClock(REFRESH_TIMER);
+  if (apb == 0)     // found valid Timer ?
+    return false;
+
+  if (_MBED_LCD_TIM->DIER & TIM_DIER_UIE)              // timer is common, already running for other display
+    return true;
+
+  if (!(RCC->APB1ENR & _MBED_LCD_TIM_RCC_EN))
+  {
+    RCC->APB1ENR |= _MBED_LCD_TIM_RCC_EN;
+    RCC->APB1RSTR |= _MBED_LCD_TIM_RCC_RST;
+    RCC->APB1RSTR &= ~_MBED_LCD_TIM_RCC_RST;
+  }
+
+  _MBED_LCD_TIM->CR1 = TIM_CR1_URS;
+  _MBED_LCD_TIM->CR2 = 0;
+  //    TIM3->EGR = TIM_EGR_UG;
+
+  _MBED_LCD_TIM->PSC = apb / 10000 - 1;                   // 100us = 10kHz
+  _MBED_LCD_TIM->ARR = 10000 / MBED_LCD_FRAME_RATE - 1;   // reload, 5ms for 200 fps (50 x 0.1ms)
+
+  _MBED_LCD_TIM->DIER |= TIM_DIER_UIE;
+  NVIC_EnableIRQ(_MBED_LCD_TIM_IRQn);
+
+  _MBED_LCD_TIMER_RUN();
+  //  bbUseDMA = true;
+#endif
+
+  // zbytecne, je to vychozi hodnota ... _refreshInProgress = false;
+  return true;
+}
+
+/**
+ * Area of public functions
+ */
+
+/**
+ * Fill videoram with value, bytes = columns, MSB on top
+ */
+void MBED_LCD_InitVideoRam(uint8_t val)
+{
+  _MBED_LCD_Ctx_t *ctx = _MBED_LCD_CTX;
+
+#ifdef MBED_LCD_BAND_MODE
+  ctx->bandUsed = 0;                            // new frame, empty list
+  ctx->bandOverflow = false;
+  ctx->bandBack = val;
+  ctx->bandClipDepth = 0;
+  ctx->bandChanged = true;
+#else
+  memset(_MBED_LCD_VRAM(ctx), val, _MBED_LCD_LINES * _MBED_LCD_COLUMNS); // word wide in library
+
+  _MBED_LCD_MarkAllDirty();
+#endif
+}
+
+/**
+ * Force sending of whole Video RAM at next refresh (eg. after LCD reset)
+ */
+void MBED_LCD_Invalidate(void)
+{
+  _MBED_LCD_Ctx_t *ctx = _MBED_LCD_CTX;
+
+  for(int r = 0; r < _MBED_LCD_LINES; r++)
+  {
+#ifdef MBED_LCD_BAND_MODE
+    ctx->bandFrom[r] = 0;                       // as sent in previous frame
+    ctx->bandTo[r] = _MBED_LCD_COLUMNS;
+#else
+    __atomic_store_n(&_MBED_LCD_SEND(ctx)[r], _MBED_LCD_SPAN_ALL, __ATOMIC_RELEASE);
+#endif
+  }
+#ifdef MBED_LCD_BAND_MODE
+  ctx->bandChanged = true;
+#endif
+
+  _MBED_LCD_wake_refresh();
+}
+
+/**
+ * Set frame rate of auto-refresh (1 .. 1000 fps), default is MBED_LCD_FRAME_RATE
+ * Returns false for invalid value or without USE_DMA_REFRESH
+ */
+bool MBED_LCD_SetFrameRate(uint16_t fps)
+{
+#ifdef USE_DMA_REFRESH
+  if ((fps < 1) || (fps > 1000))
+    return false;
+
+#ifndef MBED_LCD_HOST
+  _MBED_LCD_TIM->ARR = 10000 / fps - 1;
+  if (_MBED_LCD_TIM->CNT > _MBED_LCD_TIM->ARR)        // would count over 16 bits to reload
+    _MBED_LCD_TIM->CNT = 0;
+#endif
+
+  return true;
+#else
+  (void)fps;
+  return false;
+#endif
+}
+
+/**
+ * Block start of refresh while drawing, waits for end of running refresh
+ * Calls can be nested, each must be paired with MBED_LCD_UnlockVideoRam()
+ */
+void MBED_LCD_LockVideoRam(void)
+{
+  _MBED_LCD_Ctx_t *ctx = _MBED_LCD_CTX;
+
+  ctx->drawLock++;
+
+  while (ctx->refreshInProgress)              // DMA reads Video RAM directly, wait for its end
+    MBED_LCD_OS_WAIT();
+}
+
+/**
+ * Release lock from MBED_LCD_LockVideoRam(), refresh can start again
+ */
+void MBED_LCD_UnlockVideoRam(void)
+{
+  _MBED_LCD_Ctx_t *ctx = _MBED_LCD_CTX;
+
+  if (ctx->drawLock > 0)
+    ctx->drawLock--;
+
+  if (ctx->drawLock == 0)
+    _MBED_LCD_wake_refresh();                 // changes made while locked
+}
+
+#ifdef MBED_LCD_DOUBLE_BUFFER
+/**
+ * Exchange back and front buffer, refresh sends changed parts of new front buffer
+ * Changed spans are copied to new back buffer, so drawing continues over last frame
+ * Scroll of back buffer is repeated in new back buffer, not sent changes of front are moved with it
+ * With publish the frame gets next sequence number while refresh is excluded (see MBED_LCD_EndFrame)
+ * Returns false if refresh is running, call again later
+ */
+static bool _MBED_LCD_swap(bool publish)
+{
+  _MBED_LCD_Ctx_t *ctx = _MBED_LCD_CTX;
+
+  if (!_MBED_LCD_claim_refresh())             // refresh cannot start between test and exchange
+    return false;
+
+  if (publish)
+    ctx->frameSeq++;
+
+  ctx->back ^= 1;
+
+  if (ctx->scrolled > 0)
+  {
+    _MBED_LCD_ShiftPages(_MBED_LCD_VRAM(ctx), ctx->scrolled);
+    for (uint8_t r = 0; r < _MBED_LCD_LINES; r++)
+      ctx->send[r] = (r + ctx->scrolled < _MBED_LCD_LINES) ? ctx->send[r + ctx->scrolled] : _MBED_LCD_SPAN_EMPTY;
+#ifdef MBED_LCD_OVERLAY
+    for (uint8_t i = 0; i < MBED_LCD_OVERLAY_ITEMS; i++)  // overlay stays, its old image moved with content
+      _MBED_LCD_OverlayMark(&ctx->overlay[i], true);
+#endif
+
+    ctx->frontHead = ctx->pageHead;
+    ctx->scrolled = 0;
+  }
+
+  for (uint8_t r = 0; r < _MBED_LCD_LINES; r++)
+  {
+    uint16_t span = ctx->dirty[r];
+    uint8_t from = _MBED_LCD_SPAN_FROM(span);
+    uint8_t to = _MBED_LCD_SPAN_TO(span);
+
+    if (from >= to)
+      continue;
+
+    memcpy(&_MBED_LCD_VRAM(ctx)[r][from], &_MBED_LCD_FRONT(ctx)[r][from], to - from);
+    _MBED_LCD_PROF_ADD(fbBytes, to - from);
+
+    _MBED_LCD_SpanJoin(&ctx->send[r], from, to);       // join with not sent changes of previous frame
+    ctx->dirty[r] = _MBED_LCD_SPAN_EMPTY;
+  }
+
+  _MBED_LCD_unclaim_refresh();
+  _MBED_LCD_wake_refresh();
+  return true;
+}
+
+/**
+ * Publish back buffer - exchange it with front buffer, refresh sends its changed parts
+ * Returns false if refresh is running, call again later
+ */
+bool MBED_LCD_SwapBuffers(void)
+{
+  return _MBED_LCD_swap(false);
+}
+#endif
+
+/**
+ * Wait until frame seq of display ctx is on LCD (polled mode sends it, selected display must be ctx)
+ */
+static void _MBED_LCD_wait_frame(const _MBED_LCD_Ctx_t *ctx, uint32_t seq)
+{
+  while ((int32_t)(ctx->doneSeq - seq) < 0)             // like vertical blank, frame is sent
+  {
+#ifndef USE_DMA_REFRESH
+    if (MBED_LCD_VideoRam2LCD())
+      continue;
+#endif
+    MBED_LCD_OS_WAIT();
+  }
+}
+
+/**
+ * Wait until all frames published by MBED_LCD_EndFrame() are on LCD
+ */
+void MBED_LCD_WaitFrame(void)
+{
+  _MBED_LCD_Ctx_t *ctx = _MBED_LCD_CTX;
+
+  _MBED_LCD_wait_frame(ctx, ctx->frameSeq);
+}
+
+/**
+ * Set callback called when published frame is on LCD (from interrupt with USE_DMA_REFRESH), NULL = none
+ * Called after end of refresh, Video RAM (front buffer) is free at that time
+ */
+void MBED_LCD_SetFrameCallback(MBED_LCD_Callback_t done)
+{
+  _MBED_LCD_CTX->frameDone = done;
+}
+
+/**
+ * Start frame transaction - refresh never sends state between Begin and End
+ * Single buffer locks Video RAM (waits for running refresh), double buffer draws to back buffer
+ * Calls can be nested, only outermost MBED_LCD_EndFrame() publishes frame
+ * With RTOS (MBED_LCD_OS_LOCK) one task draws between Begin and End, select display after Begin
+ */
+void MBED_LCD_BeginFrame(void)
+{
+  MBED_LCD_OS_LOCK();
+
+#ifdef MBED_LCD_DOUBLE_BUFFER
+  _MBED_LCD_CTX->frameDepth++;
+#else
+  MBED_LCD_LockVideoRam();
+#endif
+}
+
+/**
+ * Finish frame transaction and publish frame to refresh immediately (polled mode sends it here)
+ * With wait = true returns after whole frame is on LCD
+ */
+void MBED_LCD_EndFrame(bool wait)
+{
+  _MBED_LCD_Ctx_t *ctx = _MBED_LCD_CTX;                 // other task can select other display after unlock
+  uint32_t seq;
+
+#ifdef MBED_LCD_DOUBLE_BUFFER
+  if ((ctx->frameDepth == 0) || (--ctx->frameDepth > 0)) // not outermost
+  {
+    MBED_LCD_OS_UNLOCK();
+    return;
+  }
+
+  while (!_MBED_LCD_swap(true))                         // only while refresh is running
+    MBED_LCD_OS_WAIT();
+  seq = ctx->frameSeq;
+#else
+  if ((ctx->drawLock == 0) || (ctx->drawLock > 1))      // not outermost
+  {
+    MBED_LCD_UnlockVideoRam();
+    MBED_LCD_OS_UNLOCK();
+    return;
+  }
+
+  seq = ++ctx->frameSeq;                                // refresh cannot start before unlock
+  ctx->drawLock = 0;
+#endif
+
+#ifdef USE_DMA_REFRESH
+  _MBED_LCD_wake_refresh();                             // next ticks, when this one finds SPI busy
+  _MBED_LCD_TIMER_PEND();                               // refresh timer interrupt starts transfer now
+  MBED_LCD_OS_UNLOCK();                                 // others can draw while this task waits
+
+  if (wait)
+    _MBED_LCD_wait_frame(ctx, seq);
+#else
+  MBED_LCD_VideoRam2LCD();
+  if (wait)
+    _MBED_LCD_wait_frame(ctx, seq);
+
+  MBED_LCD_OS_UNLOCK();
+#endif
+}
+
+/**
+ * Returns count of bytes sent to LCD (commands + data) since last clear
+ */
+uint32_t MBED_LCD_GetSentBytes(void)
+{
+  return _MBED_LCD_CTX->sentBytes;
+}
+
+/**
+ * Clears counter of sent bytes
+ */
+void MBED_LCD_ClearSentBytes(void)
+{
+  _MBED_LCD_CTX->sentBytes = 0;
+}
+
+/**
+ * Set clock for refresh statistics, returns ticks of free running counter (NULL = no timing)
+ * Default is DWT cycle counter on target, nothing on host
+ */
+void MBED_LCD_SetClock(uint32_t (*clock)(void))
+{
+  m_clock = clock;
+}
+
+static void _MBED_LCD_TimeGet(const _MBED_LCD_TimeAcc_t *acc, MBED_LCD_Timing_t *t)
+{
+  t->count = acc->count;
+  t->min = acc->min;
+  t->max = acc->max;
+  t->avg = (acc->count > 0) ? (uint32_t)(acc->sum / acc->count) : 0;
+}
+
+/**
+ * Copy of refresh statistics, durations are in ticks of clock (see MBED_LCD_SetClock)
+ */
+void MBED_LCD_GetStats(MBED_LCD_Stats_t *stats)
+{
+  _MBED_LCD_Ctx_t *ctx = _MBED_LCD_CTX;
+
+  stats->refreshStarted = ctx->refreshStarted;
+  stats->refreshCompleted = ctx->refreshCompleted;
+  stats->refreshSkipped = ctx->refreshSkipped;
+  stats->refreshNoChange = ctx->refreshNoChange;
+  stats->spiBytes = ctx->sentBytes;
+
+  _MBED_LCD_TimeGet(&ctx->timeRefresh, &stats->refresh);
+  _MBED_LCD_TimeGet(&ctx->timeDmaIsr, &stats->dmaIsr);
+  _MBED_LCD_TimeGet(&m_timeTimerIsr, &stats->timerIsr);
+}
+
+/**
+ * Clear refresh statistics including counter of sent bytes
+ */
+void MBED_LCD_ResetStats(void)
+{
+  _MBED_LCD_Ctx_t *ctx = _MBED_LCD_CTX;
+
+  ctx->refreshStarted = 0;
+  ctx->refreshCompleted = 0;
+  ctx->refreshSkipped = 0;
+  ctx->refreshNoChange = 0;
+  ctx->sentBytes = 0;
+
+  memset(&ctx->timeRefresh, 0, sizeof(ctx->timeRefresh));
+  memset(&ctx->timeDmaIsr, 0, sizeof(ctx->timeDmaIsr));
+  memset(&m_timeTimerIsr, 0, sizeof(m_timeTimerIsr));
+}
+
+#ifdef MBED_LCD_PROFILE
+/**
+ * Copy profiling counters (global symbol MBED_LCD_PROFILE)
+ */
+void MBED_LCD_GetProfile(MBED_LCD_Profile_t *prof)
+{
+  *prof = m_profile;
+}
+
+/**
+ * Clear profiling counters
+ */
+void MBED_LCD_ClearProfile(void)
+{
+  memset(&m_profile, 0, sizeof(m_profile));
+}
+#endif
+
+/**
+ * Select display for following calls (0 .. MBED_LCD_INSTANCES - 1), each has own Video RAM, refresh and statistics
+ * Call MBED_LCD_init() once for each display. Returns false for invalid index, selection is not changed
+ */
+bool MBED_LCD_Select(uint8_t index)
+{
+  if (index >= MBED_LCD_INSTANCES)
+    return false;
+
+#if (MBED_LCD_INSTANCES > 1)
+  _lcdIndex = index;
+#endif
+  return true;
+}
+
+/**
+ * Returns index of selected display
+ */
+uint8_t MBED_LCD_GetSelected(void)
+{
+  return _MBED_LCD_INDEX;
+}
+
+static const uint8_t m_initCmds[] =
+{
+  0xAE,     //  display off
+  0xA2,     //  bias voltage
+
+  0xA0,
+  0xC8,     //  colum normal
+
+  0x22,     //  voltage resistor ratio
+  0x2F,     //  power on
+  //0xA4,   //  LCD display ram
+  0x40,     //  start line 0
+  0xAF,     // display ON
+
+  0x81,     //  set contrast
+  0x17,     //  set contrast
+
+  0xA6,     // display normal
+//  0xA7,   // display inverted
+//  0xa5,
+};
+
+/**
+ * Initialisation - HW parts and init commands for LCD controller (see DS and MBED sample init code)
+ * Returns false if ini fails
+ */
+bool MBED_LCD_init(void)
+{
+  if (!MBED_LCD_PortInit(_MBED_LCD_INDEX))  // check success of HW init
+    return false;
+
+  MBED_LCD_PortReset(_MBED_LCD_INDEX);
+
+  MBED_LCD_sendCommands(m_initCmds, sizeof(m_initCmds));   // whole sequence under one CS
+  _MBED_LCD_CTX->lcdHead = 0;
+
+  MBED_LCD_Invalidate();      // content of LCD RAM is undefined after reset
+#ifndef MBED_LCD_HOST
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;   // DWT cycle counter for statistics
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+  _MBED_LCD_init_hw_refresh();
+  return true;                // ALL init OK
+}
+
+typedef enum
+{
+  _MBED_LCD_CLIP_OUT = 0,                               ///< Nothing visible, skip whole shape
+  _MBED_LCD_CLIP_PART,                                  ///< Check each pixel
+  _MBED_LCD_CLIP_IN,                                    ///< Fully visible, no checks needed
+} _MBED_LCD_ClipResult_t;
+
+static void _MBED_LCD_ClipIntersect(_MBED_LCD_Clip_t *clip, int x, int y, int w, int h)  ///< Limit clip by rectangle
+{
+  int x1 = x + w;
+  int y1 = y + h;
+
+  if (x > clip->x0) clip->x0 = (x < clip->x1) ? x : clip->x1;
+  if (y > clip->y0) clip->y0 = (y < clip->y1) ? y : clip->y1;
+  if (x1 < clip->x1) clip->x1 = (x1 > clip->x0) ? x1 : clip->x0;
+  if (y1 < clip->y1) clip->y1 = (y1 > clip->y0) ? y1 : clip->y0;
+}
+
+static inline bool _MBED_LCD_InClip(int x, int y)
+{
+  return (x >= _MBED_LCD_CLIP.x0) && (x < _MBED_LCD_CLIP.x1) && (y >= _MBED_LCD_CLIP.y0) && (y < _MBED_LCD_CLIP.y1);
+}
+
+/**
+ * Bounding box x0..x1, y0..y1 (including both, x0 <= x1, y0 <= y1) against clip
+ */
+static _MBED_LCD_ClipResult_t _MBED_LCD_ClipBox(int x0, int y0, int x1, int y1)
+{
+  if ((x1 < _MBED_LCD_CLIP.x0) || (x0 >= _MBED_LCD_CLIP.x1) || (y1 < _MBED_LCD_CLIP.y0) || (y0 >= _MBED_LCD_CLIP.y1))
+    return _MBED_LCD_CLIP_OUT;
+
+  if ((x0 >= _MBED_LCD_CLIP.x0) && (x1 < _MBED_LCD_CLIP.x1) && (y0 >= _MBED_LCD_CLIP.y0) && (y1 < _MBED_LCD_CLIP.y1))
+    return _MBED_LCD_CLIP_IN;
+
+  return _MBED_LCD_CLIP_PART;
+}
+
+static inline uint8_t _MBED_LCD_RowMask(int page, int y0, int y1)  ///< Rows y0 .. y1-1 in page, bit per row (LSB on top)
+{
+  int top = y0 - page * 8;
+  int bottom = y1 - page * 8;
+  uint8_t mask = 0xFF;
+
+  if ((top >= 8) || (bottom <= 0))
+    return 0;
+
+  if (top > 0)
+    mask &= 0xFF << top;
+  if (bottom < 8)
+    mask &= 0xFF >> (8 - bottom);
+
+  return mask;
+}
+
+static inline uint8_t _MBED_LCD_ClipRows(int page)    ///< Rows of page inside clip
+{
+  return _MBED_LCD_RowMask(page, _MBED_LCD_CLIP.y0, _MBED_LCD_CLIP.y1);
+}
+
+static inline void _MBED_LCD_Plot(int x, int y, bool color)  ///< Pixel without any check, must be inside clip
+{
+  _MBED_LCD_Ctx_t *ctx = _MBED_LCD_CTX;
+
+  if (color)
+    _MBED_LCD_ROW(ctx, y / 8)[x] |= 1 << (y % 8);
+  else
+    _MBED_LCD_ROW(ctx, y / 8)[x] &= ~(1 << (y % 8));
+
+  _MBED_LCD_MarkDirty(y / 8, x, x + 1);
+}
+
+static inline void _MBED_LCD_PlotIf(bool inside, int x, int y, bool color)  ///< Pixel checked only for partly visible shape
+{
+  if (inside || _MBED_LCD_InClip(x, y))
+    _MBED_LCD_Plot(x, y, color);
+}
+
+/**
+ * Set clip rectangle x,y with size w x h, limited by display. Does not change saved clips
+ */
+void MBED_LCD_SetClip(int x, int y, int w, int h)
+{
+#ifdef MBED_LCD_BAND_MODE
+  if (!_MBED_LCD_CTX->bandRender)
+  {
+    _MBED_LCD_BandShape(_MBED_LCD_BAND_CLIP_SET, x, y, w, h, 0, NULL, 0);
+    return;
+  }
+#endif
+  _MBED_LCD_CLIP = _MBED_LCD_CLIP_LIMIT;
+  _MBED_LCD_ClipIntersect(&_MBED_LCD_CLIP, x, y, w, h);
+}
+
+/**
+ * Clip to whole display, saved clips are dropped
+ */
+void MBED_LCD_ResetClip(void)
+{
+  _MBED_LCD_Ctx_t *ctx = _MBED_LCD_CTX;
+
+#ifdef MBED_LCD_BAND_MODE
+  if (!ctx->bandRender)
+  {
+    _MBED_LCD_BandPut(_MBED_LCD_BAND_CLIP_RESET, NULL, 0, NULL, 0);
+    ctx->bandClipDepth = 0;
+    return;
+  }
+#endif
+  _MBED_LCD_CLIP = _MBED_LCD_CLIP_LIMIT;
+  ctx->clipDepth = 0;
+}
+
+/**
+ * Save current clip and limit it by rectangle x,y with size w x h (intersection)
+ * Returns false when MBED_LCD_CLIP_DEPTH clips are saved already, clip is not changed
+ */
+bool MBED_LCD_PushClip(int x, int y, int w, int h)
+{
+  _MBED_LCD_Ctx_t *ctx = _MBED_LCD_CTX;
+
+#ifdef MBED_LCD_BAND_MODE
+  if (!ctx->bandRender)
+  {
+    if (ctx->bandClipDepth >= MBED_LCD_CLIP_DEPTH)
+      return false;
+
+    ctx->bandClipDepth++;
+    _MBED_LCD_BandShape(_MBED_LCD_BAND_CLIP_PUSH, x, y, w, h, 0, NULL, 0);
+    return true;
+  }
+#endif
+  if (ctx->clipDepth >= MBED_LCD_CLIP_DEPTH)
+    return false;
+
+  ctx->clipStack[ctx->clipDepth++] = _MBED_LCD_CLIP;
+  _MBED_LCD_ClipIntersect(&_MBED_LCD_CLIP, x, y, w, h);
+  return true;
+}
+
+/**
+ * Restore clip saved by MBED_LCD_PushClip(), false when nothing is saved
+ */
+bool MBED_LCD_PopClip(void)
+{
+  _MBED_LCD_Ctx_t *ctx = _MBED_LCD_CTX;
+
+#ifdef MBED_LCD_BAND_MODE
+  if (!ctx->bandRender)
+  {
+    if (ctx->bandClipDepth == 0)
+      return false;
+
+    ctx->bandClipDepth--;
+    _MBED_LCD_BandPut(_MBED_LCD_BAND_CLIP_POP, NULL, 0, NULL, 0);
+    return true;
+  }
+#endif
+  if (ctx->clipDepth == 0)
+    return false;
+
+  _MBED_LCD_CLIP = ctx->clipStack[--ctx->clipDepth];
+  return true;
+}
+
+/**
+ * Font definition - pure data for 8x8 pixel characters, 0-127 code
+ */
+#include "font_8x8.h"       ///< Font defintion, 128 characters with ASCII codes 0..127
+
+const MBED_LCD_Font_t MBED_LCD_Font8x8 = { 8, 8, 0, '?', 0, 128, NULL, NULL, NULL, font8x8_basic };
+
+#define _MBED_LCD_FONT      ((_MBED_LCD_CTX->font != NULL) ? _MBED_LCD_CTX->font : &MBED_LCD_Font8x8)
+
+/**
+ * Index of glyph for code c, subset is searched by halving, codes not in font get glyph font->missing
+ */
+static uint8_t _MBED_LCD_GlyphIndex(const MBED_LCD_Font_t *font, uint8_t c)
+{
+  if (font->codes == NULL)
+    return ((c >= font->first) && (c - font->first < font->count)) ? (c - font->first) : font->missing;
+
+  int lo = 0, hi = font->count - 1;
+
+  while (lo <= hi)
+  {
+    int mid = (lo + hi) / 2;
+
+    if (font->codes[mid] == c)
+      return mid;
+    if (font->codes[mid] < c)
+      lo = mid + 1;
+    else
+      hi = mid - 1;
+  }
+
+  return font->missing;
+}
+
+static inline uint8_t _MBED_LCD_GlyphWidth(const MBED_LCD_Font_t *font, uint8_t g)  ///< Columns of glyph, without spacing
+{
+  return (font->widths != NULL) ? font->widths[g] : font->width;
+}
+
+static inline const uint8_t *_MBED_LCD_GlyphData(const MBED_LCD_Font_t *font, uint8_t g)  ///< Page format, band by band
+{
+  if (font->offsets != NULL)
+    return &font->data[font->offsets[g]];
+  return &font->data[g * font->width * ((font->height + 7) / 8)];
+}
+
+#ifdef MBED_LCD_GLYPH_CACHE
+/**
+ * Glyph band pre-shifted for text at y not aligned to page (y % 8 = shift)
+ * Column is band << shift - low byte goes to upper page, high byte to lower page
+ */
+typedef struct
+{
+  const uint8_t *src;                                 ///< Band in font data (key with shift and width), NULL = free
+  uint32_t used;                                      ///< Time of last use, oldest entry of set is replaced
+  uint8_t shift;
+  uint8_t width;
+  uint16_t col[MBED_LCD_GLYPH_CACHE_WIDTH];
+} _MBED_LCD_GlyphCache_t;
+
+#define _MBED_LCD_GC_WAYS   4                         ///< Entries searched for one key (set)
+#define _MBED_LCD_GC_SETS   ((MBED_LCD_GLYPH_CACHE / (_MBED_LCD_GC_WAYS * sizeof(_MBED_LCD_GlyphCache_t)) > 0) \
+                            ? (MBED_LCD_GLYPH_CACHE / (_MBED_LCD_GC_WAYS * sizeof(_MBED_LCD_GlyphCache_t))) : 1)
+
+static _MBED_LCD_GlyphCache_t m_glyphCache[_MBED_LCD_GC_SETS][_MBED_LCD_GC_WAYS];  ///< Common for all displays
+static MBED_LCD_GlyphCacheStats_t m_glyphCacheStats;
+static uint32_t m_glyphCacheClock;
+
+/**
+ * Columns of band src (w columns) shifted by shift - found in cache or shifted now, replacing least recently used
+ */
+static inline const uint16_t *_MBED_LCD_GlyphCacheGet(const uint8_t *src, uint8_t w, uint8_t shift)
+{
+  uint32_t hash = (((uint32_t)(uintptr_t)src + shift) * 2654435761u) >> 16;   // mixes glyph strides of any font
+  _MBED_LCD_GlyphCache_t *set = m_glyphCache[hash % _MBED_LCD_GC_SETS];
+  _MBED_LCD_GlyphCache_t *e = &set[0];
+
+  m_glyphCacheClock++;
+  for (int k = 0; k < _MBED_LCD_GC_WAYS; k++)
+  {
+    if ((set[k].src == src) && (set[k].shift == shift) && (set[k].width == w))
+    {
+      set[k].used = m_glyphCacheClock;
+      m_glyphCacheStats.hits++;
+      return set[k].col;
+    }
+    if (set[k].used < e->used)                        // free entries were never used (0)
+      e = &set[k];
+  }
+
+  m_glyphCacheStats.misses++;
+  if (e->src != NULL)
+    m_glyphCacheStats.evictions++;
+
+  e->src = src;
+  e->shift = shift;
+  e->width = w;
+  e->used = m_glyphCacheClock;
+  for (int i = 0; i < w; i++)
+    e->col[i] = src[i] << shift;
+
+  return e->col;
+}
+
+/**
+ * Write columns i0 .. i1-1 of pre-shifted band to page and page + 1, columns from w are spacing (cleared)
+ */
+static inline void _MBED_LCD_BlitCached(const uint16_t *col, int w, uint8_t rows, int x, int i0, int i1, int page, uint8_t shift)
+{
+  _MBED_LCD_Ctx_t *ctx = _MBED_LCD_CTX;
+  int n = ((i1 < w) ? i1 : w) - i0;                     // glyph columns, rest of i1 - i0 is spacing
+
+  col += i0;
+
+  if ((page >= 0) && (page < _MBED_LCD_LINES))          // upper part - low bytes
+  {
+    uint8_t mask = (uint8_t)(rows << shift) & _MBED_LCD_ClipRows(page);
+    uint8_t *dst = &_MBED_LCD_ROW(ctx, page)[x + i0];
+
+    if (mask)
+    {
+      for (int i = 0; i < n; i++)
+        dst[i] = (dst[i] & ~mask) | (col[i] & mask);
+      for (int i = n; i < i1 - i0; i++)
+        dst[i] &= ~mask;
+
+      _MBED_LCD_MarkDirty(page, x + i0, x + i1);
+    }
+  }
+
+  if ((page + 1 >= 0) && (page + 1 < _MBED_LCD_LINES))  // lower part - high bytes
+  {
+    uint8_t mask = (rows >> (8 - shift)) & _MBED_LCD_ClipRows(page + 1);
+    uint8_t *dst = &_MBED_LCD_ROW(ctx, page + 1)[x + i0];
+
+    if (mask)
+    {
+      for (int i = 0; i < n; i++)
+        dst[i] = (dst[i] & ~mask) | ((col[i] >> 8) & mask);
+      for (int i = n; i < i1 - i0; i++)
+        dst[i] &= ~mask;
+
+      _MBED_LCD_MarkDirty(page + 1, x + i0, x + i1);
+    }
+  }
+}
+
+/**
+ * Copy glyph cache counters (global symbol MBED_LCD_GLYPH_CACHE)
+ */
+void MBED_LCD_GetGlyphCacheStats(MBED_LCD_GlyphCacheStats_t *stats)
+{
+  *stats = m_glyphCacheStats;
+  stats->entries = _MBED_LCD_GC_SETS * _MBED_LCD_GC_WAYS;
+}
+
+/**
+ * Drop all pre-shifted glyphs and clear counters - needed only when font data in RAM is changed
+ */
+void MBED_LCD_ResetGlyphCache(void)
+{
+  memset(m_glyphCache, 0, sizeof(m_glyphCache));
+  memset(&m_glyphCacheStats, 0, sizeof(m_glyphCacheStats));
+  m_glyphCacheClock = 0;
+}
+#endif
+
+/**
+ * Write columns i0 .. i1-1 of one glyph band (rows = its rows, LSB on top) shifted down by shift
+ * to page and page + 1, columns from w are spacing (cleared). Clipped by rows of clip rectangle
+ */
+static inline void _MBED_LCD_BlitBand(const uint8_t *src, int w, uint8_t rows, int x, int i0, int i1, int page, uint8_t shift)
+{
+  _MBED_LCD_Ctx_t *ctx = _MBED_LCD_CTX;
+  int iw = (i1 < w) ? i1 : w;                           // glyph columns i0 .. iw-1, spacing iw .. i1-1
+
+#ifdef MBED_LCD_GLYPH_CACHE
+  if ((shift != 0) && (w <= MBED_LCD_GLYPH_CACHE_WIDTH))
+  {
+    _MBED_LCD_BlitCached(_MBED_LCD_GlyphCacheGet(src, w, shift), w, rows, x, i0, i1, page, shift);
+    return;
+  }
+#endif
+
+  if ((page >= 0) && (page < _MBED_LCD_LINES))          // upper (or only) part
+  {
+    uint8_t mask = (uint8_t)(rows << shift) & _MBED_LCD_ClipRows(page);
+    uint8_t *dst = &_MBED_LCD_ROW(ctx, page)[x + i0];
+    int i = i0;
+
+    if (mask == 0xFF)                                   // fast path, byte per column (shift is 0)
+    {
+      for (; i < iw; i++)
+        *dst++ = src[i];
+      for (; i < i1; i++)
+        *dst++ = 0;
+    }
+    else if (mask)
+    {
+      for (; i < iw; i++, dst++)
+        *dst = (*dst & ~mask) | ((uint8_t)(src[i] << shift) & mask);
+      for (; i < i1; i++, dst++)
+        *dst &= ~mask;
+    }
+
+    if (mask)
+      _MBED_LCD_MarkDirty(page, x + i0, x + i1);
+  }
+
+  if ((shift != 0) && (page + 1 >= 0) && (page + 1 < _MBED_LCD_LINES))   // lower part
+  {
+    uint8_t mask = (uint8_t)(rows >> (8 - shift)) & _MBED_LCD_ClipRows(page + 1);
+    uint8_t *dst = &_MBED_LCD_ROW(ctx, page + 1)[x + i0];
+    int i = i0;
+
+    if (mask)
+    {
+      for (; i < iw; i++, dst++)
+        *dst = (*dst & ~mask) | ((src[i] >> (8 - shift)) & mask);
+      for (; i < i1; i++, dst++)
+        *dst &= ~mask;
+
+      _MBED_LCD_MarkDirty(page + 1, x + i0, x + i1);
+    }
+  }
+}
+
+/**
+ * Copy glyph (w columns, h rows in (h + 7) / 8 bands, LSB on top, same as page layout) to Video RAM
+ * Overwrites background of whole cell - cell - w columns of spacing are cleared
+ * Aligned y writes whole bytes, otherwise each band is shifted and merged into two pages
+ * Clipped by clip rectangle - columns by range, rows by mask of each page
+ */
+static inline void _MBED_LCD_BlitGlyph(const uint8_t *glyph, int w, int cell, int h, int x, int y)
+{
+  int c0 = (x > _MBED_LCD_CLIP.x0) ? x : _MBED_LCD_CLIP.x0; // visible columns c0 .. c1-1
+  int c1 = ((x + cell) < _MBED_LCD_CLIP.x1) ? (x + cell) : _MBED_LCD_CLIP.x1;
+
+  if ((c0 >= c1) || (y >= _MBED_LCD_CLIP.y1) || ((y + h) <= _MBED_LCD_CLIP.y0))
+    return;
+
+  int page = (y >= 0) ? (y / 8) : -((7 - y) / 8);      // rounded down also for y < 0
+  uint8_t shift = y - page * 8;
+
+  for (int b = 0; b * 8 < h; b++, page++, glyph += w)
+  {
+    uint8_t rows = (h - b * 8 >= 8) ? 0xFF : (0xFF >> (8 - (h - b * 8)));
+
+    _MBED_LCD_BlitBand(glyph, w, rows, x, c0 - x, c1 - x, page, shift);
+  }
+}
+
+/**
+ * Draw character c of font at x,y (top left of cell), returns advance (glyph width + spacing)
+ */
+static inline int _MBED_LCD_DrawChar(const MBED_LCD_Font_t *font, char c, int x, int y)
+{
+  uint8_t g = _MBED_LCD_GlyphIndex(font, (uint8_t)c);
+  int w = _MBED_LCD_GlyphWidth(font, g);
+
+  _MBED_LCD_BlitGlyph(_MBED_LCD_GlyphData(font, g), w, w + font->spacing, font->height, x, y);
+  return w + font->spacing;
+}
+
+/**
+ * Draw len characters (len < 0 = up to end of string) of font from x,y (top left)
+ * Characters starting behind right margin are skipped, returns x behind last drawn character
+ */
+static int _MBED_LCD_Text(const MBED_LCD_Font_t *font, int x, int y, const char *cp, int len)
+{
+#ifdef MBED_LCD_BAND_MODE
+  if (!_MBED_LCD_CTX->bandRender)
+  {
+    _MBED_LCD_BandText_t t = { x, y, font };
+    int n = 0;
+
+    while (((len < 0) ? (cp[n] != 0) : (n < len)) && (x < _MBED_LCD_COLUMNS) && (n < 255 - (int)sizeof(t)))
+      x += _MBED_LCD_GlyphWidth(font, _MBED_LCD_GlyphIndex(font, (uint8_t)cp[n++])) + font->spacing;
+
+    _MBED_LCD_BandPut(_MBED_LCD_BAND_TEXT, &t, sizeof(t), cp, n);
+    return x;
+  }
+#endif
+  for (int n = 0; ((len < 0) ? (cp[n] != 0) : (n < len)) && (x < _MBED_LCD_COLUMNS); n++)
+    x += _MBED_LCD_DrawChar(font, cp[n], x, y);
+
+  return x;
+}
+
+/**
+ * Select font of text functions with pixel position (XY, MBED_LCD_DrawText), NULL = MBED_LCD_Font8x8
+ * Font is used by pointer, it must stay valid (const in flash). CR functions and console use 8x8 grid
+ */
+void MBED_LCD_SetFont(const MBED_LCD_Font_t *font)
+{
+  _MBED_LCD_CTX->font = font;
+}
+
+/**
+ * Returns selected font
+ */
+const MBED_LCD_Font_t *MBED_LCD_GetFont(void)
+{
+  return _MBED_LCD_FONT;
+}
+
+/**
+ * Width of text in selected font in pixels (with spacing after each character)
+ */
+int MBED_LCD_GetTextWidth(const char *cp)
+{
+  const MBED_LCD_Font_t *font = _MBED_LCD_FONT;
+  int w = 0;
+
+  for (; *cp; cp++)
+    w += _MBED_LCD_GlyphWidth(font, _MBED_LCD_GlyphIndex(font, (uint8_t)*cp)) + font->spacing;
+
+  return w;
+}
+
+/**
+ * Draw text in selected font, x,y is top left corner (may be outside display), cells overwrite background
+ * Clipped by clip rectangle, returns x behind last drawn character
+ */
+int MBED_LCD_DrawText(int x, int y, const char *cp)
+{
+  if (cp == NULL)
+    return x;
+
+  return _MBED_LCD_Text(_MBED_LCD_FONT, x, y, cp, -1);
+}
+
+/**
+ * Writes 8x8 character at position - counted in "chars"
+ * Return false if coordinates are outside working area
+ */
+bool MBED_LCD_WriteCharCR(char c, uint8_t col, uint8_t row)
+{
+  /* old code, required for direct write byte-by-byte to "line" memory
+  int i;
+
+  if ((col > _MBED_LCD_COLUMNS / 8) || (row > (_MBED_LCD_ROWS - 1)))
+    return false;
+
+  if (c > 127)
+    c %= 128;
+
+  for (i = 0; i < 8; i++)
+    _MBED_LCD_VRAM(_MBED_LCD_CTX)[row][col * 8 + i] = font8x8_basic[c * 8 + i];
+
+  return true;
+  */
+
+  if ((col >= _MBED_LCD_CHAR_PER_LINE) || (row >= _MBED_LCD_LINES))
+    return false;
+
+  _MBED_LCD_Text(&MBED_LCD_Font8x8, col * 8, row * 8, &c, 1);
+  return true;
+}
+
+/**
+ * Writes character of selected font at position - counted in "pixels"
+ * Return false if coordinates are outside working area
+ */
+bool MBED_LCD_WriteCharXY(char c, uint8_t x, uint8_t y)
+{
+  if ((x >= _MBED_LCD_COLUMNS) || (y >= _MBED_LCD_ROWS))
+    return false;
+
+  _MBED_LCD_Text(_MBED_LCD_FONT, x, y, &c, 1);
+  return true;
+}
+
+/**
+ * Writes string of 8x8 character at position
+ * Return false if coordinates of first chracter are outside working area
+ * Characters behind end of line are skipped
+ */
+bool MBED_LCD_WriteStringCR(char *cp, uint8_t col, uint8_t row)
+{
+  if ((col >= _MBED_LCD_CHAR_PER_LINE) || (row > (_MBED_LCD_LINES - 1)))
+    return false;
+
+  _MBED_LCD_Text(&MBED_LCD_Font8x8, col * 8, row * 8, cp, -1);
+  return true;
+}
+
+/**
+ * Writes string of selected font at position - entered in pixels
+ * Return false if coordinates of first chracter are outside working area
+ * Last visible character is clipped at right margin (or clip rectangle)
+ */
+bool MBED_LCD_WriteStringXY(char *cp, uint8_t x, uint8_t y)
+{
+  if ((x >= _MBED_LCD_COLUMNS) || (y >= _MBED_LCD_ROWS))
+    return false;
+
+  _MBED_LCD_Text(_MBED_LCD_FONT, x, y, cp, -1);
+  return true;
+}
+
+/**
+ * Number to text without printf - decimal with decimals digits after point (fixed point), or hexadecimal (unsigned)
+ * Width > 0 pads to width (spaces, or zeros between sign and digits), number longer than width gives width of '#'
+ * Buffer needs max(width, MBED_LCD_FMT_MAX) + 1 bytes, returns length of text
+ */
+int MBED_LCD_FormatNumber(char *buf, int32_t value, uint8_t width, uint8_t decimals, uint8_t flags)
+{
+  char digits[MBED_LCD_FMT_MAX];                        // reversed, with decimal point
+  bool hex = (flags & MBED_LCD_FMT_HEX) != 0;
+  uint32_t u = (hex || (value >= 0)) ? (uint32_t)value : 0u - (uint32_t)value;
+  char sign = (!hex && (value < 0)) ? '-' : ((flags & MBED_LCD_FMT_PLUS) ? '+' : 0);
+  int n = 0, len, pad;
+
+  if (hex)
+  {
+    do
+    {
+      digits[n++] = "0123456789ABCDEF"[u & 0x0F];
+      u >>= 4;
+    } while (u != 0);
+  }
+  else
+  {
+    if (decimals > 9)
+      decimals = 9;
+
+    do
+    {
+      if ((decimals > 0) && (n == decimals))
+        digits[n++] = '.';
+      digits[n++] = '0' + u % 10;
+      u /= 10;
+    } while ((u != 0) || (n <= decimals));              // at least one digit before point
+  }
+
+  len = n + (sign != 0);
+  if ((width > 0) && (len > width))                     // does not fit, never show wrong value
+  {
+    memset(buf, '#', width);
+    buf[width] = 0;
+    return width;
+  }
+
+  pad = (width > len) ? width - len : 0;
+  len = 0;
+
+  if (!(flags & (MBED_LCD_FMT_LEFT | MBED_LCD_FMT_ZERO)))
+    for (; pad > 0; pad--)
+      buf[len++] = ' ';
+  if (sign)
+    buf[len++] = sign;
+  if (flags & MBED_LCD_FMT_ZERO)
+    for (; pad > 0; pad--)
+      buf[len++] = '0';
+  while (n > 0)
+    buf[len++] = digits[--n];
+  for (; pad > 0; pad--)                                // left aligned
+    buf[len++] = ' ';
+
+  buf[len] = 0;
+  return len;
+}
+
+#ifndef MBED_LCD_BAND_MODE
+/**
+ * Draw character c of font to fixed cell (widest glyph + spacing), rest of cell is cleared
+ */
+static inline void _MBED_LCD_DrawCell(const MBED_LCD_Font_t *font, char c, int x, int y)
+{
+  uint8_t g = _MBED_LCD_GlyphIndex(font, (uint8_t)c);
+
+  _MBED_LCD_BlitGlyph(_MBED_LCD_GlyphData(font, g), _MBED_LCD_GlyphWidth(font, g), font->width + font->spacing, font->height, x, y);
+}
+
+/**
+ * Field of width characters at x,y (top left) in selected font, each character has cell of widest glyph
+ * Nothing is drawn now, first value draws whole field
+ */
+void MBED_LCD_FieldInit(MBED_LCD_Field_t *f, int x, int y, uint8_t width, uint8_t decimals, uint8_t flags)
+{
+  f->x = x;
+  f->y = y;
+  f->width = (width < 1) ? 1 : ((width > MBED_LCD_FIELD_CHARS) ? MBED_LCD_FIELD_CHARS : width);
+  f->decimals = decimals;
+  f->flags = flags;
+  f->font = _MBED_LCD_FONT;
+  f->valid = false;
+}
+
+/**
+ * Next draw of field writes all characters - after display or area of field was cleared
+ */
+void MBED_LCD_FieldInvalidate(MBED_LCD_Field_t *f)
+{
+  f->valid = false;
+}
+
+/**
+ * Show text in field (aligned and padded like number), only characters different from shown ones are drawn
+ */
+void MBED_LCD_FieldSetText(MBED_LCD_Field_t *f, const char *cp)
+{
+  int cell = f->font->width + f->font->spacing;
+  int len = 0, pad;
+
+  while ((len < f->width) && cp[len])
+    len++;
+  pad = (f->flags & MBED_LCD_FMT_LEFT) ? 0 : f->width - len;
+
+  for (int i = 0; i < f->width; i++)
+  {
+    char c = ((i < pad) || (i >= pad + len)) ? ' ' : cp[i - pad];
+
+    if (f->valid && (f->text[i] == c))
+      continue;
+
+    _MBED_LCD_DrawCell(f->font, c, f->x + i * cell, f->y);
+    f->text[i] = c;
+  }
+
+  f->valid = true;
+}
+
+/**
+ * Show number in field - formatted by field settings (see MBED_LCD_FormatNumber), only changed digits are drawn
+ */
+void MBED_LCD_FieldSetNumber(MBED_LCD_Field_t *f, int32_t value)
+{
+  char buf[MBED_LCD_FIELD_CHARS + 1];                   // text is never longer than width of field
+
+  MBED_LCD_FormatNumber(buf, value, f->width, f->decimals, f->flags);
+  MBED_LCD_FieldSetText(f, buf);
+}
+#endif
+
+#ifndef MBED_LCD_BAND_MODE
+/**
+ * Scroll whole display up by text lines (8 pixels), bottom lines are cleared
+ * Uses start line of controller - refresh sends only the new lines and one command
+ */
+void MBED_LCD_ScrollUpLines(uint8_t lines)
+{
+  _MBED_LCD_Ctx_t *ctx = _MBED_LCD_CTX;
+
+  if (lines == 0)
+    return;
+
+  if (lines > _MBED_LCD_LINES)
+    lines = _MBED_LCD_LINES;
+
+#ifndef MBED_LCD_DOUBLE_BUFFER
+  MBED_LCD_LockVideoRam();                              // refresh must not run between move and head change
+#endif
+
+  _MBED_LCD_ShiftPages(_MBED_LCD_VRAM(ctx), lines);
+
+  for (uint8_t r = 0; r < _MBED_LCD_LINES; r++)         // changes move with content, controller has the rest
+    ctx->dirty[r] = (r + lines < _MBED_LCD_LINES) ? ctx->dirty[r + lines] : _MBED_LCD_SPAN_ALL;
+  _MBED_LCD_PROF_ADD(fbBytes, lines * _MBED_LCD_COLUMNS);
+
+  ctx->pageHead = (ctx->pageHead + lines) % _MBED_LCD_RAM_PAGES;
+#if defined(MBED_LCD_OVERLAY) && !defined(MBED_LCD_DOUBLE_BUFFER)
+  for (uint8_t i = 0; i < MBED_LCD_OVERLAY_ITEMS; i++)  // controller moves overlay with content
+    _MBED_LCD_OverlayMark(&ctx->overlay[i], true);
+#endif
+#ifdef MBED_LCD_DOUBLE_BUFFER
+  ctx->scrolled = (ctx->scrolled + lines > _MBED_LCD_LINES) ? _MBED_LCD_LINES : (ctx->scrolled + lines);
+#else
+  MBED_LCD_UnlockVideoRam();
+#endif
+}
+
+/**
+ * Text console - cursor in characters (conCol, conRow), wrap at end of line, scroll at bottom
+ */
+static void _MBED_LCD_ConsoleNewLine(void)
+{
+  _MBED_LCD_Ctx_t *ctx = _MBED_LCD_CTX;
+
+  ctx->conCol = 0;
+  if (ctx->conRow + 1 < _MBED_LCD_LINES)
+    ctx->conRow++;
+  else
+    MBED_LCD_ScrollUpLines(1);
+}
+
+/**
+ * Clear display and move cursor to top left corner
+ */
+void MBED_LCD_ConsoleClear(void)
+{
+  _MBED_LCD_Ctx_t *ctx = _MBED_LCD_CTX;
+
+  MBED_LCD_InitVideoRam(0x00);
+  ctx->conCol = 0;
+  ctx->conRow = 0;
+}
+
+/**
+ * Write one character to console
+ * \n = new line (incl. return), \r = return to line start, \t = next tab stop, others 0..127 are printed
+ * Line is wrapped before character, which does not fit, so full line + \n does not make empty line
+ */
+void MBED_LCD_ConsolePutChar(char c)
+{
+  _MBED_LCD_Ctx_t *ctx = _MBED_LCD_CTX;
+
+  switch (c)
+  {
+    case '\n':
+      _MBED_LCD_ConsoleNewLine();
+      break;
+
+    case '\r':
+      ctx->conCol = 0;
+      break;
+
+    case '\t':
+      if (ctx->conCol >= _MBED_LCD_CHAR_PER_LINE)
+        _MBED_LCD_ConsoleNewLine();
+
+      do                                                // spaces clear rest of tab
+      {
+        _MBED_LCD_DrawChar(&MBED_LCD_Font8x8, ' ', ctx->conCol * 8, ctx->conRow * 8);
+        ctx->conCol++;
+      } while ((ctx->conCol % MBED_LCD_CONSOLE_TAB) && (ctx->conCol < _MBED_LCD_CHAR_PER_LINE));
+      break;
+
+    default:
+      if (ctx->conCol >= _MBED_LCD_CHAR_PER_LINE)
+        _MBED_LCD_ConsoleNewLine();
+
+      _MBED_LCD_DrawChar(&MBED_LCD_Font8x8, c, ctx->conCol * 8, ctx->conRow * 8);
+      ctx->conCol++;
+      break;
+  }
+}
+
+/**
+ * Write string to console, see MBED_LCD_ConsolePutChar()
+ */
+void MBED_LCD_ConsoleWrite(const char *cp)
+{
+  for (; *cp; cp++)
+    MBED_LCD_ConsolePutChar(*cp);
+}
+#endif // MBED_LCD_BAND_MODE
+
+/**
+ * Puts pixel with color black = 1, background = 0
+ * Pixels outside clip rectangle are ignored
+ */
+void MBED_LCD_PutPixel(uint8_t x, uint8_t y, bool black)
+{
+#ifdef MBED_LCD_BAND_MODE
+  if (!_MBED_LCD_CTX->bandRender)
+  {
+    _MBED_LCD_BandShape(_MBED_LCD_BAND_PIXEL, x, y, 0, 0, black, NULL, 0);
+    return;
+  }
+#endif
+  _MBED_LCD_PROF_ADD(putPixelCalls, 1);
+  if (!_MBED_LCD_InClip(x, y))
+    return;
+
+  _MBED_LCD_Plot(x, y, black);
+}
+
+/**
+ * Bytes of one page changed by masks, dst = (dst & keep) ^ flip
+ * Four columns in one 32-bit word (SWAR), unaligned access by memcpy (single load/store on Cortex-M4)
+ */
+static void _MBED_LCD_SpanOp(uint8_t *dst, int cnt, uint8_t keep, uint8_t flip)
+{
+  uint32_t k = keep * 0x01010101u;
+  uint32_t f = flip * 0x01010101u;
+  uint32_t w;
+
+  for (; cnt >= 4; cnt -= 4, dst += 4)
+  {
+    memcpy(&w, dst, 4);
+    w = (w & k) ^ f;
+    memcpy(dst, &w, 4);
+  }
+
+  for (; cnt; cnt--, dst++)
+    *dst = (*dst & keep) ^ flip;
+}
+
+typedef enum
+{
+  _MBED_LCD_AREA_CLEAR = 0,
+  _MBED_LCD_AREA_SET,
+  _MBED_LCD_AREA_INVERT,
+} _MBED_LCD_AreaOp_t;
+
+/**
+ * Span engine - clear, set or invert area x0..x1, y0..y1 (including both)
+ * Each page is processed by one mask for all columns, full pages by memset
+ * Horizontal span is area with y0 == y1, vertical span is area with x0 == x1
+ * Coordinates can be in any order, area is clipped by clip rectangle
+ */
+static void _MBED_LCD_ModifyArea(int x0, int y0, int x1, int y1, _MBED_LCD_AreaOp_t op)
+{
+  int t;
+
+  if (x0 > x1)
+  {
+    t = x0; x0 = x1; x1 = t;
+  }
+  if (y0 > y1)
+  {
+    t = y0; y0 = y1; y1 = t;
+  }
+
+  if (x0 < _MBED_LCD_CLIP.x0) x0 = _MBED_LCD_CLIP.x0;
+  if (y0 < _MBED_LCD_CLIP.y0) y0 = _MBED_LCD_CLIP.y0;
+  if (x1 > (_MBED_LCD_CLIP.x1 - 1)) x1 = _MBED_LCD_CLIP.x1 - 1;
+  if (y1 > (_MBED_LCD_CLIP.y1 - 1)) y1 = _MBED_LCD_CLIP.y1 - 1;
+
+  if ((x0 > x1) || (y0 > y1))                           // nothing visible
+    return;
+
+  for (int p = y0 / 8; p <= y1 / 8; p++)
+  {
+    uint8_t mask = 0xFF;
+    uint8_t *dst = &_MBED_LCD_ROW(_MBED_LCD_CTX, p)[x0];
+    int cnt = x1 - x0 + 1;
+
+    if (p == y0 / 8)
+      mask &= 0xFF << (y0 % 8);                         // first page, rows from y0
+    if (p == y1 / 8)
+      mask &= 0xFF >> (7 - y1 % 8);                     // last page, rows up to y1
+
+    if (op == _MBED_LCD_AREA_INVERT)
+      _MBED_LCD_SpanOp(dst, cnt, 0xFF, mask);
+    else if (mask == 0xFF)
+      memset(dst, (op == _MBED_LCD_AREA_SET) ? 0xFF : 0x00, cnt);
+    else
+      _MBED_LCD_SpanOp(dst, cnt, ~mask, (op == _MBED_LCD_AREA_SET) ? mask : 0);
+
+    _MBED_LCD_MarkDirty(p, x0, x1 + 1);
+  }
+}
+
+static inline void _MBED_LCD_FillArea(int x0, int y0, int x1, int y1, bool color)
+{
+  _MBED_LCD_ModifyArea(x0, y0, x1, y1, color ? _MBED_LCD_AREA_SET : _MBED_LCD_AREA_CLEAR);
+}
+
+/**
+ * Draw line with color black = 1, background = 0
+ * Coordinates x,y of start point a x,y of end point, end point is not drawn
+ * Bresenham algorithm used (see rosetacode.org), horizontal and vertical lines by span
+ * Clipped by clip rectangle, pixels are checked only when line is partly visible
+ */
+void MBED_LCD_DrawLine(int x0, int y0, int x1, int y1, bool color)
+{
+#ifdef MBED_LCD_BAND_MODE
+  if (!_MBED_LCD_CTX->bandRender)
+  {
+    _MBED_LCD_BandShape(_MBED_LCD_BAND_LINE, x0, y0, x1, y1, color, NULL, 0);
+    return;
+  }
+#endif
+  if (y0 == y1)                                         // horizontal
+  {
+    if (x0 != x1)
+      _MBED_LCD_FillArea(x0, y0, (x0 < x1) ? (x1 - 1) : (x1 + 1), y0, color);
+    return;
+  }
+
+  if (x0 == x1)                                         // vertical
+  {
+    _MBED_LCD_FillArea(x0, y0, x0, (y0 < y1) ? (y1 - 1) : (y1 + 1), color);
+    return;
+  }
+
+  int dx = (x0 < x1) ? (x1 - x0) : (x0 - x1), sx = (x0 < x1) ? 1 : -1;
+  int dy = (y0 < y1) ? (y1 - y0) : (y0 - y1), sy = (y0 < y1) ? 1 : -1;
+  int err = ((dx > dy) ? dx : -dy) / 2, e2;
+  _MBED_LCD_ClipResult_t clip = _MBED_LCD_ClipBox((sx > 0) ? x0 : x1, (sy > 0) ? y0 : y1, (sx > 0) ? x1 : x0, (sy > 0) ? y1 : y0);
+
+  if (clip == _MBED_LCD_CLIP_OUT)
+    return;
+
+  for (; ; )
+  {
+    if ((x0 == x1) && (y0 == y1))
+      break;
+
+    _MBED_LCD_PlotIf(clip == _MBED_LCD_CLIP_IN, x0, y0, color);
+
+    e2 = err;
+    if (e2 > -dx)
+    {
+      err -= dy; x0 += sx;
+    }
+
+    if (e2 < dy)
+    {
+      err += dx; y0 += sy;
+    }
+  }
+}
+
+/**
+ * Draw lines as rectangle with color black = 1, background = 0
+ * Corners are x,y and x+w,y+h, clipped by clip rectangle
+ */
+void MBED_LCD_DrawRect(int x, int y, int w, int h, bool color)
+{
+#ifdef MBED_LCD_BAND_MODE
+  if (!_MBED_LCD_CTX->bandRender)
+  {
+    _MBED_LCD_BandShape(_MBED_LCD_BAND_RECT, x, y, w, h, color, NULL, 0);
+    return;
+  }
+#endif
+  _MBED_LCD_FillArea(x, y, x + w, y, color);
+  _MBED_LCD_FillArea(x, y + h, x + w, y + h, color);
+  _MBED_LCD_FillArea(x, y, x, y + h, color);
+  _MBED_LCD_FillArea(x + w, y, x + w, y + h, color);
+}
+
+/**
+ * Draw lines as filled rectangle with color black = 1, background = 0
+ * Size w x h pixels, clipped by clip rectangle
+ */
+void MBED_LCD_FillRect(int x, int y, int w, int h, bool color)
+{
+  if ((w <= 0) || (h <= 0))
+    return;
+
+#ifdef MBED_LCD_BAND_MODE
+  if (!_MBED_LCD_CTX->bandRender)
+  {
+    _MBED_LCD_BandShape(_MBED_LCD_BAND_FILL_RECT, x, y, w, h, color, NULL, 0);
+    return;
+  }
+#endif
+  _MBED_LCD_FillArea(x, y, x + w - 1, y + h - 1, color);
+}
+
+/**
+ * Invert pixels of rectangle w x h (highlight bar of menu), clipped by clip rectangle
+ */
+void MBED_LCD_InvertRect(int x, int y, int w, int h)
+{
+  if ((w <= 0) || (h <= 0))
+    return;
+
+#ifdef MBED_LCD_BAND_MODE
+  if (!_MBED_LCD_CTX->bandRender)
+  {
+    _MBED_LCD_BandShape(_MBED_LCD_BAND_INVERT_RECT, x, y, w, h, 0, NULL, 0);
+    return;
+  }
+#endif
+  _MBED_LCD_ModifyArea(x, y, x + w - 1, y + h - 1, _MBED_LCD_AREA_INVERT);
+}
+
+/**
+ * Draw circle with color black = 1, background = 0
+ * Algorithm see rosetacode.org
+ * Bounding box is checked once against clip rectangle, pixels only when circle is partly visible
+ */
+void MBED_LCD_DrawCircle(int centerX, int centerY, int radius, bool colorSet)
+{
+  int d = (5 - radius * 4) / 4;
+  int x = 0;
+  int y = radius;
+
+  if (radius < 0)
+    return;
+
+#ifdef MBED_LCD_BAND_MODE
+  if (!_MBED_LCD_CTX->bandRender)
+  {
+    _MBED_LCD_BandShape(_MBED_LCD_BAND_CIRCLE, centerX, centerY, radius, 0, colorSet, NULL, 0);
+    return;
+  }
+#endif
+  _MBED_LCD_ClipResult_t clip = _MBED_LCD_ClipBox(centerX - radius, centerY - radius, centerX + radius, centerY + radius);
+  bool in = (clip == _MBED_LCD_CLIP_IN);
+
+  if (clip == _MBED_LCD_CLIP_OUT)
+    return;
+
+  do
+  {
+    _MBED_LCD_PlotIf(in, centerX + x, centerY + y, colorSet);
+    _MBED_LCD_PlotIf(in, centerX + x, centerY - y, colorSet);
+    _MBED_LCD_PlotIf(in, centerX - x, centerY + y, colorSet);
+    _MBED_LCD_PlotIf(in, centerX - x, centerY - y, colorSet);
+    _MBED_LCD_PlotIf(in, centerX + y, centerY + x, colorSet);
+    _MBED_LCD_PlotIf(in, centerX + y, centerY - x, colorSet);
+    _MBED_LCD_PlotIf(in, centerX - y, centerY + x, colorSet);
+    _MBED_LCD_PlotIf(in, centerX - y, centerY - x, colorSet);
+    if (d < 0)
+    {
+      d += 2 * x + 1;
+    }
+    else
+    {
+      d += 2 * (x - y) + 1;
+      y--;
+    }
+    x++;
+  } while (x <= y);
+}
+
+/**
+ * Draw filled circle with color black = 1, background = 0
+ * Composed from vertical spans, clipped by clip rectangle
+ */
+void MBED_LCD_FillCircle(int x0, int y0, int radius, bool color)
+{
+  int f = 1 - radius;
+  int ddF_x = 0;
+  int ddF_y = -2 * (int)radius;
+  int x = 0;
+  int y = (int)radius;
+
+#ifdef MBED_LCD_BAND_MODE
+  if (!_MBED_LCD_CTX->bandRender)
+  {
+    _MBED_LCD_BandShape(_MBED_LCD_BAND_FILL_CIRCLE, x0, y0, radius, 0, color, NULL, 0);
+    return;
+  }
+#endif
+  if ((radius < 0) || (_MBED_LCD_ClipBox(x0 - radius, y0 - radius, x0 + radius, y0 + radius) == _MBED_LCD_CLIP_OUT))
+    return;
+
+  _MBED_LCD_FillArea(x0, y0 - radius, x0, y0 + radius, color);    // center column
+
+  while(x < y)
+  {
+    if(f >= 0)
+    {
+        y--;
+        ddF_y += 2;
+        f += ddF_y;
+    }
+    x++;
+    ddF_x += 2;
+    f += ddF_x + 1;
+
+    _MBED_LCD_FillArea(x0 + x, y0 - y, x0 + x, y0 + y, color);
+    _MBED_LCD_FillArea(x0 - x, y0 - y, x0 - x, y0 + y, color);
+    _MBED_LCD_FillArea(x0 + y, y0 - x, x0 + y, y0 + x, color);
+    _MBED_LCD_FillArea(x0 - y, y0 - x, x0 - y, y0 + x, color);
+  }
+}
+
+/**
+ * Band (8 rows) of page format bitmap, NULL outside bitmap
+ */
+static inline const uint8_t *_MBED_LCD_BmpBand(const MBED_LCD_Bitmap_t *bmp, const uint8_t *data, int band)
+{
+  if ((data == NULL) || (band < 0) || (band * 8 >= bmp->height))
+    return NULL;
+
+  return &data[band * bmp->width];
+}
+
+/**
+ * 8 columns of row format bitmap (byte group) for rows row .. row+7 to page bytes (LSB on top)
+ * Bit matrix 8x8 is transposed by 32-bit operations (see Hacker's Delight, transpose8)
+ */
+static void _MBED_LCD_BmpRows8(const MBED_LCD_Bitmap_t *bmp, const uint8_t *data, int group, int row, uint8_t *out)
+{
+  int stride = (bmp->width + 7) / 8;
+  uint8_t in[8];
+  uint32_t x, y, t;
+
+  for (int i = 0; i < 8; i++)                           // bottom row first, so row 0 goes to LSB
+  {
+    int r = row + 7 - i;
+    in[i] = ((r >= 0) && (r < bmp->height)) ? data[r * stride + group] : 0;
+  }
+
+  x = ((uint32_t)in[0] << 24) | ((uint32_t)in[1] << 16) | ((uint32_t)in[2] << 8) | in[3];
+  y = ((uint32_t)in[4] << 24) | ((uint32_t)in[5] << 16) | ((uint32_t)in[6] << 8) | in[7];
+
+  t = (x ^ (x >> 7)) & 0x00AA00AA;  x = x ^ t ^ (t << 7);
+  t = (y ^ (y >> 7)) & 0x00AA00AA;  y = y ^ t ^ (t << 7);
+  t = (x ^ (x >> 14)) & 0x0000CCCC; x = x ^ t ^ (t << 14);
+  t = (y ^ (y >> 14)) & 0x0000CCCC; y = y ^ t ^ (t << 14);
+  t = (x & 0xF0F0F0F0) | ((y >> 4) & 0x0F0F0F0F);
+  y = ((x << 4) & 0xF0F0F0F0) | (y & 0x0F0F0F0F);
+  x = t;
+
+  out[0] = x >> 24; out[1] = x >> 16; out[2] = x >> 8; out[3] = x;      // out[k] = column k (MSB on left)
+  out[4] = y >> 24; out[5] = y >> 16; out[6] = y >> 8; out[7] = y;
+}
+
+/**
+ * Combine page p of bitmap placed at x,y with bytes of columns c0 .. c1-1 (dst = column c0), only rows of mask rows
+ * Each byte is combined with shifted bytes of bitmap, one column = one byte operation
+ */
+static void _MBED_LCD_BmpPage(const MBED_LCD_Bitmap_t *bmp, int x, int y, int p, int c0, int c1, uint8_t rows,
+    MBED_LCD_Rop_t rop, uint8_t *dst)
+{
+  int row = p * 8 - y;                                  // bitmap row at top of page
+  int band = (row >= 0) ? (row / 8) : -((7 - row) / 8); // band at top of page, rounded down
+  uint8_t shift = row - band * 8;                       // upper band shifted right, lower band left
+  const uint8_t *up = _MBED_LCD_BmpBand(bmp, bmp->data, band);
+  const uint8_t *low = shift ? _MBED_LCD_BmpBand(bmp, bmp->data, band + 1) : NULL;
+  const uint8_t *upMask = _MBED_LCD_BmpBand(bmp, bmp->mask, band);
+  const uint8_t *lowMask = shift ? _MBED_LCD_BmpBand(bmp, bmp->mask, band + 1) : NULL;
+  uint8_t srcBuf[8], maskBuf[8];
+
+  for (int c = c0; c < c1; c++, dst++)
+  {
+    int col = c - x;
+    uint8_t src = 0, m = rows;
+
+    if (bmp->format == MBED_LCD_BMP_PAGES)
+    {
+      if (up != NULL)
+        src = up[col] >> shift;
+      if (low != NULL)
+        src |= low[col] << (8 - shift);
+
+      if (bmp->mask != NULL)
+        m &= ((upMask != NULL) ? (upMask[col] >> shift) : 0) | ((lowMask != NULL) ? (lowMask[col] << (8 - shift)) : 0);
+    }
+    else
+    {
+      if ((c == c0) || ((col % 8) == 0))                // next byte group of rows
+      {
+        _MBED_LCD_BmpRows8(bmp, bmp->data, col / 8, row, srcBuf);
+        if (bmp->mask != NULL)
+          _MBED_LCD_BmpRows8(bmp, bmp->mask, col / 8, row, maskBuf);
+      }
+
+      src = srcBuf[col % 8];
+      if (bmp->mask != NULL)
+        m &= maskBuf[col % 8];
+    }
+
+    switch (rop)
+    {
+      case MBED_LCD_ROP_COPY:   *dst = (*dst & ~m) | (src & m); break;
+      case MBED_LCD_ROP_OR:     *dst |= src & m;                break;
+      case MBED_LCD_ROP_AND:    *dst &= src | ~m;               break;
+      case MBED_LCD_ROP_XOR:    *dst ^= src & m;                break;
+      case MBED_LCD_ROP_ANDNOT: *dst &= ~(src & m);             break;
+    }
+  }
+}
+
+/**
+ * Draw bitmap with raster operation, top left corner at x,y, clipped by clip rectangle
+ * Pixels with 0 in mask (when mask is used) are not changed
+ */
+void MBED_LCD_DrawBitmap(int x, int y, const MBED_LCD_Bitmap_t *bmp, MBED_LCD_Rop_t rop)
+{
+  _MBED_LCD_Ctx_t *ctx = _MBED_LCD_CTX;
+
+  if ((bmp == NULL) || (bmp->data == NULL) || (bmp->width == 0) || (bmp->height == 0))
+    return;
+
+#ifdef MBED_LCD_BAND_MODE
+  if (!ctx->bandRender)
+  {
+    _MBED_LCD_BandBitmap_t b = { x, y, rop, *bmp };
+
+    _MBED_LCD_BandPut(_MBED_LCD_BAND_BITMAP, &b, sizeof(b), NULL, 0);
+    return;
+  }
+#endif
+
+  int c0 = (x > _MBED_LCD_CLIP.x0) ? x : _MBED_LCD_CLIP.x0; // visible columns c0 .. c1-1
+  int c1 = ((x + bmp->width) < _MBED_LCD_CLIP.x1) ? (x + bmp->width) : _MBED_LCD_CLIP.x1;
+  int r0 = (y > _MBED_LCD_CLIP.y0) ? y : _MBED_LCD_CLIP.y0; // visible rows r0 .. r1-1
+  int r1 = ((y + bmp->height) < _MBED_LCD_CLIP.y1) ? (y + bmp->height) : _MBED_LCD_CLIP.y1;
+
+  if ((c0 >= c1) || (r0 >= r1))
+    return;
+
+  for (int p = r0 / 8; p <= (r1 - 1) / 8; p++)
+  {
+    _MBED_LCD_BmpPage(bmp, x, y, p, c0, c1, _MBED_LCD_RowMask(p, r0, r1), rop, &_MBED_LCD_ROW(ctx, p)[c0]);
+    _MBED_LCD_MarkDirty(p, c0, c1);
+  }
+}
+
+/**
+ * Draw binary sprite to position, data is array of rows (8 pixels wide, MSB on left)
+ * parameter rows = count of rows (height)
+ * color - 1 = set pixels are black, 0 = set pixels are cleared, others aren't changed
+ */
+void MBED_LCD_DrawSpriteMono8(int x, int y, uint8_t *data, int rows, bool color)
+{
+  MBED_LCD_Bitmap_t bmp;
+
+  if ((data == NULL) || (rows <= 0))
+    return;
+
+  bmp.width = 8;
+  bmp.height = rows;
+  bmp.format = MBED_LCD_BMP_ROWS;
+  bmp.data = data;
+  bmp.mask = NULL;
+
+  MBED_LCD_DrawBitmap(x, y, &bmp, color ? MBED_LCD_ROP_OR : MBED_LCD_ROP_ANDNOT);
+}
+
+#ifndef MBED_LCD_BAND_MODE
+/**
+ * Column engine - whole column (4 pages) in one 32-bit word, bit = row (LSB on top)
+ * Vertical move of any count of pixels is one shift, rows are selected by mask
+ */
+#if (_MBED_LCD_ROWS > 32)
+#error Column operations keep whole column in 32 bits
+#endif
+
+static inline uint32_t _MBED_LCD_RowsMask(int y0, int y1)  ///< Rows y0 .. y1-1 (0 <= y0 < y1 <= 32)
+{
+  return ((y1 - y0 >= 32) ? 0xFFFFFFFFu : ((1u << (y1 - y0)) - 1)) << y0;
+}
+
+static inline uint32_t _MBED_LCD_ShiftColumn(uint32_t col, int dy)   ///< Positive = down
+{
+  if ((dy >= 32) || (dy <= -32))
+    return 0;
+
+  return (dy >= 0) ? (col << dy) : (col >> -dy);
+}
+
+static inline uint32_t _MBED_LCD_GetColumn(int x)     ///< Outside display = background (0)
+{
+  uint32_t col = 0;
+
+  if ((x < 0) || (x >= _MBED_LCD_COLUMNS))
+    return 0;
+
+  for (int p = 0; p < _MBED_LCD_LINES; p++)
+    col |= (uint32_t)_MBED_LCD_ROW(_MBED_LCD_CTX, p)[x] << (p * 8);
+
+  return col;
+}
+
+static inline void _MBED_LCD_PutColumn(int x, uint32_t col, uint32_t mask)  ///< Only rows of mask are written
+{
+  _MBED_LCD_Ctx_t *ctx = _MBED_LCD_CTX;
+
+  for (int p = 0; p < _MBED_LCD_LINES; p++)
+  {
+    uint8_t m = mask >> (p * 8);
+
+    if (m != 0)
+      _MBED_LCD_ROW(ctx, p)[x] = (_MBED_LCD_ROW(ctx, p)[x] & ~m) | ((col >> (p * 8)) & m);
+  }
+}
+
+/**
+ * Copy rows of mask from src to dst (bytes of page), dst and src can overlap
+ * Four columns in one 32-bit word, direction against the move
+ */
+static void _MBED_LCD_MoveSpan(uint8_t *dst, const uint8_t *src, int cnt, uint8_t mask)
+{
+  uint32_t m = mask * 0x01010101u;
+  uint32_t a, b;
+
+  if (mask == 0xFF)
+  {
+    memmove(dst, src, cnt);
+    return;
+  }
+
+  if (dst <= src)
+  {
+    for (; cnt >= 4; cnt -= 4, dst += 4, src += 4)
+    {
+      memcpy(&a, src, 4);
+      memcpy(&b, dst, 4);
+      b = (b & ~m) | (a & m);
+      memcpy(dst, &b, 4);
+    }
+
+    for (; cnt; cnt--, dst++, src++)
+      *dst = (*dst & ~mask) | (*src & mask);
+  }
+  else
+  {
+    dst += cnt;
+    src += cnt;
+    for (; cnt >= 4; cnt -= 4)
+    {
+      dst -= 4;
+      src -= 4;
+      memcpy(&a, src, 4);
+      memcpy(&b, dst, 4);
+      b = (b & ~m) | (a & m);
+      memcpy(dst, &b, 4);
+    }
+
+    for (; cnt; cnt--)
+    {
+      dst--;
+      src--;
+      *dst = (*dst & ~mask) | (*src & mask);
+    }
+  }
+}
+
+/**
+ * Copy to area c0..c1-1, r0..r1-1 (inside display) from the same area moved by ox, oy
+ * Source and destination can overlap - columns go against the move, whole column is read before write
+ * Move by whole pages (horizontal scroll too) is done by spans of pages
+ */
+static void _MBED_LCD_CopyArea(int c0, int r0, int c1, int r1, int ox, int oy)
+{
+  _MBED_LCD_Ctx_t *ctx = _MBED_LCD_CTX;
+
+  if ((oy % 8 == 0) && (c0 + ox >= 0) && (c1 + ox <= _MBED_LCD_COLUMNS)
+      && (r0 + oy >= 0) && (r1 + oy <= _MBED_LCD_ROWS))
+  {
+    int dir = (oy > 0) ? 1 : -1;                        // destination page first, before it is read
+    int p0 = r0 / 8, p1 = (r1 - 1) / 8;
+    int p = (dir > 0) ? p0 : p1;
+
+    for (int n = p1 - p0 + 1; n; n--, p += dir)
+      _MBED_LCD_MoveSpan(&_MBED_LCD_ROW(ctx, p)[c0], &_MBED_LCD_ROW(ctx, p + oy / 8)[c0 + ox], c1 - c0, _MBED_LCD_RowMask(p, r0, r1));
+  }
+  else
+  {
+    uint32_t mask = _MBED_LCD_RowsMask(r0, r1);
+    int dir = (ox >= 0) ? 1 : -1;
+    int c = (dir > 0) ? c0 : (c1 - 1);
+
+    for (int n = c1 - c0; n; n--, c += dir)
+      _MBED_LCD_PutColumn(c, _MBED_LCD_ShiftColumn(_MBED_LCD_GetColumn(c + ox), -oy), mask);
+  }
+
+  for (int p = r0 / 8; p <= (r1 - 1) / 8; p++)
+    _MBED_LCD_MarkDirty(p, c0, c1);
+}
+
+/**
+ * Copy rectangle w x h from sx,sy to dx,dy, areas can overlap
+ * Destination is clipped by clip rectangle, source pixels outside display are background (0)
+ */
+void MBED_LCD_CopyRect(int sx, int sy, int w, int h, int dx, int dy)
+{
+  int c0 = (dx > _MBED_LCD_CLIP.x0) ? dx : _MBED_LCD_CLIP.x0; // visible destination c0 .. c1-1, r0 .. r1-1
+  int c1 = ((dx + w) < _MBED_LCD_CLIP.x1) ? (dx + w) : _MBED_LCD_CLIP.x1;
+  int r0 = (dy > _MBED_LCD_CLIP.y0) ? dy : _MBED_LCD_CLIP.y0;
+  int r1 = ((dy + h) < _MBED_LCD_CLIP.y1) ? (dy + h) : _MBED_LCD_CLIP.y1;
+
+  if ((w <= 0) || (h <= 0) || (c0 >= c1) || (r0 >= r1))
+    return;
+
+  _MBED_LCD_CopyArea(c0, r0, c1, r1, sx - dx, sy - dy);
+}
+
+/**
+ * Move content of clip rectangle by dx, dy pixels (positive = right, down), uncovered part is filled by color
+ * Whole display without clip, set clip for ticker or list box
+ */
+void MBED_LCD_Scroll(int dx, int dy, bool color)
+{
+  int x0 = _MBED_LCD_CLIP.x0, y0 = _MBED_LCD_CLIP.y0, x1 = _MBED_LCD_CLIP.x1, y1 = _MBED_LCD_CLIP.y1;
+
+  if ((x0 >= x1) || (y0 >= y1))
+    return;
+
+  if ((dx >= x1 - x0) || (-dx >= x1 - x0) || (dy >= y1 - y0) || (-dy >= y1 - y0))
+  {
+    _MBED_LCD_FillArea(x0, y0, x1 - 1, y1 - 1, color);   // everything is moved out
+    return;
+  }
+
+  if ((dx == 0) && (dy == 0))
+    return;
+
+  _MBED_LCD_CopyArea(x0 + ((dx > 0) ? dx : 0), y0 + ((dy > 0) ? dy : 0),    // part which stays in clip
+      x1 + ((dx < 0) ? dx : 0), y1 + ((dy < 0) ? dy : 0), -dx, -dy);
+
+  if (dx > 0)
+    _MBED_LCD_FillArea(x0, y0, x0 + dx - 1, y1 - 1, color);
+  else if (dx < 0)
+    _MBED_LCD_FillArea(x1 + dx, y0, x1 - 1, y1 - 1, color);
+
+  if (dy > 0)
+    _MBED_LCD_FillArea(x0, y0, x1 - 1, y0 + dy - 1, color);
+  else if (dy < 0)
+    _MBED_LCD_FillArea(x0, y1 + dy, x1 - 1, y1 - 1, color);
+}
+
+/**
+ * Save rectangle w x h at x,y to buffer as page format bitmap, MBED_LCD_RECT_SIZE(w, h) bytes
+ * Not limited by clip rectangle, pixels outside display are saved as background (0). Returns count of bytes
+ */
+uint16_t MBED_LCD_SaveRect(int x, int y, int w, int h, uint8_t *buf)
+{
+  int bands = (h + 7) / 8;
+
+  if ((buf == NULL) || (w <= 0) || (h <= 0))
+    return 0;
+
+  for (int i = 0; i < w; i++)
+  {
+    uint64_t col = _MBED_LCD_GetColumn(x + i);         // row y to bit 0, rectangle can start above display
+
+    if (y >= 0)
+      col = (y < 32) ? (col >> y) : 0;
+    else
+      col = (-y < 64) ? (col << -y) : 0;
+
+    for (int b = 0; b < bands; b++)
+      buf[b * w + i] = (b < 8) ? (uint8_t)(col >> (b * 8)) : 0;
+  }
+
+  if (h % 8)                                            // rows below rectangle are not part of it
+    for (int i = 0; i < w; i++)
+      buf[(bands - 1) * w + i] &= 0xFF >> (8 - h % 8);
+
+  return (uint16_t)(bands * w);
+}
+
+/**
+ * Strip chart - row of value, bottom row = min, top row = max, values outside are clamped
+ */
+static int _MBED_LCD_ChartRow(const MBED_LCD_Chart_t *c, int16_t v)
+{
+  int32_t span = (int32_t)c->max - c->min;
+  int32_t r = (span > 0) ? (((int32_t)v - c->min) * (c->h - 1) + span / 2) / span : 0;
+
+  if (r < 0)
+    r = 0;
+  if (r > c->h - 1)
+    r = c->h - 1;
+
+  return c->y + c->h - 1 - r;
+}
+
+/**
+ * Draw column i of chart (0 = oldest visible sample) as one 32-bit column - whole chart height is written
+ * Span of sample is extended to touch span of previous column, so single values make connected line
+ * Clip must be limited to chart already
+ */
+static void _MBED_LCD_ChartColumn(const MBED_LCD_Chart_t *c, int i)
+{
+  const MBED_LCD_ChartSample_t *s = &c->buf[(c->head + c->w - c->count + i) % c->w];
+  int x = c->x + i;
+  int top = _MBED_LCD_ChartRow(c, s->hi);
+  int bottom = _MBED_LCD_ChartRow(c, s->lo);
+
+  if ((x < _MBED_LCD_CLIP.x0) || (x >= _MBED_LCD_CLIP.x1) || (_MBED_LCD_CLIP.y0 >= _MBED_LCD_CLIP.y1))
+    return;
+
+  if (i > 0)
+  {
+    const MBED_LCD_ChartSample_t *prev = &c->buf[(c->head + c->w - c->count + i - 1) % c->w];
+    int pt = _MBED_LCD_ChartRow(c, prev->hi);
+    int pb = _MBED_LCD_ChartRow(c, prev->lo);
+
+    if (top > pb + 1)                                   // previous is higher, connect diagonally
+      top = pb + 1;
+    if (bottom < pt - 1)
+      bottom = pt - 1;
+  }
+
+  if (top < 0)
+    top = 0;
+  if (bottom > _MBED_LCD_ROWS - 1)
+    bottom = _MBED_LCD_ROWS - 1;
+
+  uint32_t mask = _MBED_LCD_RowsMask(_MBED_LCD_CLIP.y0, _MBED_LCD_CLIP.y1);
+
+  _MBED_LCD_PutColumn(x, (top <= bottom) ? _MBED_LCD_RowsMask(top, bottom + 1) : 0, mask);
+  for (int p = 0; p < _MBED_LCD_LINES; p++)
+    if ((mask >> (p * 8)) & 0xFF)
+      _MBED_LCD_MarkDirty(p, x, x + 1);
+}
+
+/**
+ * Range of visible samples of chart
+ */
+static void _MBED_LCD_ChartDataRange(MBED_LCD_Chart_t *c)
+{
+  c->dataLo = INT16_MAX;
+  c->dataHi = INT16_MIN;
+
+  for (int i = 0; i < c->count; i++)
+  {
+    const MBED_LCD_ChartSample_t *s = &c->buf[(c->head + c->w - c->count + i) % c->w];
+
+    if (s->lo < c->dataLo)
+      c->dataLo = s->lo;
+    if (s->hi > c->dataHi)
+      c->dataHi = s->hi;
+  }
+}
+
+/**
+ * Chart w x h at x,y with ring buf of w samples (given by application), values min .. max from bottom to top
+ * Autoscale sets range by visible samples, min and max are only first range. Area of chart is cleared
+ */
+void MBED_LCD_ChartInit(MBED_LCD_Chart_t *c, int x, int y, uint8_t w, uint8_t h, MBED_LCD_ChartSample_t *buf,
+    int16_t min, int16_t max, bool autoscale)
+{
+  c->x = x;
+  c->y = y;
+  c->w = (w > 0) ? w : 1;
+  c->h = (h > 0) ? h : 1;
+  c->buf = buf;
+  c->head = 0;
+  c->count = 0;
+  c->min = min;
+  c->max = max;
+  c->autoscale = autoscale;
+
+  MBED_LCD_ChartRedraw(c);
+}
+
+/**
+ * Draw whole chart from ring of samples - after change of range or when area was overwritten
+ */
+void MBED_LCD_ChartRedraw(MBED_LCD_Chart_t *c)
+{
+  _MBED_LCD_Clip_t clip = _MBED_LCD_CLIP;
+
+  _MBED_LCD_ClipIntersect(&_MBED_LCD_CLIP, c->x, c->y, c->w, c->h);
+  _MBED_LCD_FillArea(c->x, c->y, c->x + c->w - 1, c->y + c->h - 1, false);
+  for (int i = 0; i < c->count; i++)
+    _MBED_LCD_ChartColumn(c, i);
+  _MBED_LCD_CLIP = clip;
+}
+
+/**
+ * Fixed range of chart (autoscale off), chart is redrawn
+ */
+void MBED_LCD_ChartSetRange(MBED_LCD_Chart_t *c, int16_t min, int16_t max)
+{
+  c->min = min;
+  c->max = max;
+  c->autoscale = false;
+  MBED_LCD_ChartRedraw(c);
+}
+
+/**
+ * Add column with range lo .. hi (min/max envelope of samples aggregated by application)
+ * Full chart moves left by one column (page spans), only the new column is drawn
+ * Autoscale redraws whole chart when range of visible samples leaves range of chart or uses less than half of it
+ */
+void MBED_LCD_ChartAddMinMax(MBED_LCD_Chart_t *c, int16_t lo, int16_t hi)
+{
+  MBED_LCD_ChartSample_t old = c->buf[c->head];         // oldest one, leaves full chart
+  bool full = (c->count == c->w);
+  _MBED_LCD_Clip_t clip;
+
+  if (lo > hi)
+  {
+    int16_t t = lo;
+    lo = hi;
+    hi = t;
+  }
+
+  c->buf[c->head].lo = lo;
+  c->buf[c->head].hi = hi;
+  c->head = (c->head + 1) % c->w;
+  if (!full)
+    c->count++;
+
+  if (c->autoscale)
+  {
+    if (full && ((old.lo <= c->dataLo) || (old.hi >= c->dataHi)))   // extreme left chart, find new one
+      _MBED_LCD_ChartDataRange(c);
+    else if (c->count == 1)
+    {
+      c->dataLo = lo;
+      c->dataHi = hi;
+    }
+    else
+    {
+      if (lo < c->dataLo)
+        c->dataLo = lo;
+      if (hi > c->dataHi)
+        c->dataHi = hi;
+    }
+
+    int32_t margin = ((int32_t)c->dataHi - c->dataLo) / 8 + 1;   // next samples fit without redraw
+    int32_t min = c->dataLo - margin;
+    int32_t max = c->dataHi + margin;
+
+    if ((c->dataLo < c->min) || (c->dataHi > c->max) || ((max - min) * 2 < (int32_t)c->max - c->min))
+    {
+      c->min = (min < INT16_MIN) ? INT16_MIN : min;
+      c->max = (max > INT16_MAX) ? INT16_MAX : max;
+      MBED_LCD_ChartRedraw(c);
+      return;
+    }
+  }
+
+  clip = _MBED_LCD_CLIP;
+  _MBED_LCD_ClipIntersect(&_MBED_LCD_CLIP, c->x, c->y, c->w, c->h);
+  if (full)
+  {
+    MBED_LCD_Scroll(-1, 0, false);
+    if (_MBED_LCD_CLIP.x1 < c->x + c->w)                // right part is clipped, its column comes in
+      _MBED_LCD_ChartColumn(c, _MBED_LCD_CLIP.x1 - 1 - c->x);
+  }
+  _MBED_LCD_ChartColumn(c, c->count - 1);
+  _MBED_LCD_CLIP = clip;
+}
+
+/**
+ * Add one sample to chart, connected with previous one by vertical span
+ */
+void MBED_LCD_ChartAdd(MBED_LCD_Chart_t *c, int16_t value)
+{
+  MBED_LCD_ChartAddMinMax(c, value, value);
+}
+#endif
+
+/**
+ * Restore rectangle saved by MBED_LCD_SaveRect() to x,y, clipped by clip rectangle
+ */
+void MBED_LCD_RestoreRect(int x, int y, int w, int h, const uint8_t *buf)
+{
+  MBED_LCD_Bitmap_t bmp;
+
+  if ((buf == NULL) || (w <= 0) || (h <= 0))
+    return;
+
+  bmp.width = w;
+  bmp.height = h;
+  bmp.format = MBED_LCD_BMP_PAGES;
+  bmp.data = buf;
+  bmp.mask = NULL;
+
+  MBED_LCD_DrawBitmap(x, y, &bmp, MBED_LCD_ROP_COPY);
+}
+
+#ifdef MBED_LCD_OVERLAY
+/**
+ * Overlay - items are combined with front buffer while pages are sent, Video RAM is never changed
+ * Moving or blinking item resends only its old and new columns, background is not redrawn
+ */
+static bool _MBED_LCD_OverlaySet(uint8_t id, const _MBED_LCD_Overlay_t *item)
+{
+  _MBED_LCD_Ctx_t *ctx = _MBED_LCD_CTX;
+
+  if (id >= MBED_LCD_OVERLAY_ITEMS)
+    return false;
+
+  _MBED_LCD_OverlayMark(&ctx->overlay[id], false);      // old place gets Video RAM back
+  ctx->overlay[id] = *item;
+  _MBED_LCD_OverlayMark(&ctx->overlay[id], false);
+  return true;
+}
+
+/**
+ * Overlay item id is solid rectangle combined by rop (COPY / OR = black, ANDNOT = white, XOR = inverted)
+ */
+bool MBED_LCD_OverlayRect(uint8_t id, int x, int y, int w, int h, MBED_LCD_Rop_t rop)
+{
+  _MBED_LCD_Overlay_t item = { x, y, w, h, NULL, rop, true };
+
+  if ((w <= 0) || (h <= 0))
+    return false;
+  return _MBED_LCD_OverlaySet(id, &item);
+}
+
+/**
+ * Overlay item id is bitmap combined by rop like MBED_LCD_DrawBitmap(), bitmap must stay valid while shown
+ */
+bool MBED_LCD_OverlayBitmap(uint8_t id, int x, int y, const MBED_LCD_Bitmap_t *bmp, MBED_LCD_Rop_t rop)
+{
+  if ((bmp == NULL) || (bmp->data == NULL) || (bmp->width == 0) || (bmp->height == 0))
+    return false;
+
+  _MBED_LCD_Overlay_t item = { x, y, bmp->width, bmp->height, bmp, rop, true };
+
+  return _MBED_LCD_OverlaySet(id, &item);
+}
+
+/**
+ * Move overlay item id, top left corner to x,y
+ */
+bool MBED_LCD_OverlayMove(uint8_t id, int x, int y)
+{
+  if (id >= MBED_LCD_OVERLAY_ITEMS)
+    return false;
+
+  _MBED_LCD_Overlay_t item = _MBED_LCD_CTX->overlay[id];
+
+  item.x = x;
+  item.y = y;
+  return _MBED_LCD_OverlaySet(id, &item);
+}
+
+/**
+ * Show or hide overlay item id (blinking), item keeps its shape and position
+ */
+bool MBED_LCD_OverlayShow(uint8_t id, bool visible)
+{
+  _MBED_LCD_Ctx_t *ctx = _MBED_LCD_CTX;
+
+  if (id >= MBED_LCD_OVERLAY_ITEMS)
+    return false;
+  if ((ctx->overlay[id].w == 0) || (ctx->overlay[id].visible == visible))
+    return (ctx->overlay[id].w != 0);                   // item not defined yet cannot be shown
+
+  _MBED_LCD_Overlay_t item = ctx->overlay[id];
+
+  item.visible = visible;
+  return _MBED_LCD_OverlaySet(id, &item);
+}
+#endif
+
+#ifndef MBED_LCD_BAND_MODE
+/**
+ * Columns from .. to-1 of front buffer page for LCD
+ * Span covered by visible overlay item is copied to overlayBuf and combined, other is sent from Video RAM
+ */
+static const uint8_t *_MBED_LCD_SendSpan(uint8_t page, uint8_t from, uint8_t to)
+{
+  _MBED_LCD_Ctx_t *ctx = _MBED_LCD_CTX;
+
+#ifdef MBED_LCD_OVERLAY
+  bool composed = false;
+
+  for (uint8_t i = 0; i < MBED_LCD_OVERLAY_ITEMS; i++)
+  {
+    const _MBED_LCD_Overlay_t *o = &ctx->overlay[i];
+    int c0 = (o->x > from) ? o->x : from;
+    int c1 = ((o->x + o->w) < to) ? (o->x + o->w) : to;
+    uint8_t rows = _MBED_LCD_RowMask(page, o->y, o->y + o->h);
+
+    if (!o->visible || (c0 >= c1) || (rows == 0))
+      continue;
+
+    if (!composed)
+    {
+      memcpy(&ctx->overlayBuf[from], &_MBED_LCD_FRONT(ctx)[page][from], to - from);
+      composed = true;
+    }
+
+    if (o->bmp != NULL)
+      _MBED_LCD_BmpPage(o->bmp, o->x, o->y, page, c0, c1, rows, (MBED_LCD_Rop_t)o->rop, &ctx->overlayBuf[c0]);
+    else if (o->rop == MBED_LCD_ROP_XOR)
+      _MBED_LCD_SpanOp(&ctx->overlayBuf[c0], c1 - c0, 0xFF, rows);
+    else if (o->rop == MBED_LCD_ROP_ANDNOT)
+      _MBED_LCD_SpanOp(&ctx->overlayBuf[c0], c1 - c0, ~rows, 0);
+    else if (o->rop != MBED_LCD_ROP_AND)              // AND with black rectangle keeps everything
+      _MBED_LCD_SpanOp(&ctx->overlayBuf[c0], c1 - c0, ~rows, rows);
+  }
+
+  if (composed)
+    return &ctx->overlayBuf[from];
+#else
+  (void)to;
+#endif
+  return &_MBED_LCD_FRONT(ctx)[page][from];
+}
+#endif
+
+/**
+ * Compressed image (see MBED_LCD_DrawImageRLE) - span of one band, literal bytes from src or val repeated
+ * Written at column dx of page p, limited by visible columns c0 .. c1-1 and clip rows
+ */
+static void _MBED_LCD_ImageSpan(int dx, int p, const uint8_t *src, uint8_t val, int len, int c0, int c1)
+{
+  if ((p < 0) || (p >= _MBED_LCD_LINES))
+    return;
+
+  uint8_t m = _MBED_LCD_ClipRows(p);
+  int a = (dx > c0) ? dx : c0;
+  int b = ((dx + len) < c1) ? (dx + len) : c1;
+
+  if ((m == 0) || (a >= b))
+    return;
+
+  uint8_t *dst = &_MBED_LCD_ROW(_MBED_LCD_CTX, p)[a];
+
+  if (src != NULL)
+    src += a - dx;
+
+  if (m == 0xFF)                                        // whole bytes
+  {
+    if (src != NULL)
+      memcpy(dst, src, b - a);
+    else
+      memset(dst, val, b - a);
+  }
+  else
+  {
+    for (int i = 0; i < b - a; i++)
+      dst[i] = (dst[i] & ~m) | (((src != NULL) ? src[i] : val) & m);
+  }
+
+  _MBED_LCD_MarkDirty(p, a, b);
+}
+
+/**
+ * Decode compressed image to Video RAM, left column x, top page (y = page * 8), clipped by clip rectangle
+ * Runs are written directly (memset / memcpy), there is no intermediate buffer
+ * Returns false when image is damaged (content may be partly drawn)
+ */
+bool MBED_LCD_DrawImageRLE(int x, int page, const uint8_t *img, uint16_t size)
+{
+  if ((img == NULL) || (size < 2) || (img[0] == 0))
+    return false;
+
+#ifdef MBED_LCD_BAND_MODE
+  if (!_MBED_LCD_CTX->bandRender)                       // only header is checked when recorded
+  {
+    _MBED_LCD_BandImage_t b = { x, page, size, img };
+
+    _MBED_LCD_BandPut(_MBED_LCD_BAND_IMAGE, &b, sizeof(b), NULL, 0);
+    return true;
+  }
+#endif
+
+  uint8_t width = img[0];
+  uint16_t total = width * img[1];
+  uint16_t pos = 0;
+  uint16_t i = 2;
+  int c0 = (x > _MBED_LCD_CLIP.x0) ? x : _MBED_LCD_CLIP.x0; // visible columns c0 .. c1-1
+  int c1 = ((x + width) < _MBED_LCD_CLIP.x1) ? (x + width) : _MBED_LCD_CLIP.x1;
+
+  while (pos < total)
+  {
+    const uint8_t *src = NULL;
+    uint8_t val = 0;
+    uint16_t cnt;
+
+    if (i >= size)
+      return false;
+
+    if (img[i] < 0x80)                                  // literal bytes, all in image
+    {
+      cnt = img[i] + 1;
+      if (i + 1 + cnt > size)
+        return false;
+      src = &img[i + 1];
+      i += 1 + cnt;
+    }
+    else                                                // repeated byte, value in image
+    {
+      if (i + 2 > size)
+        return false;
+      cnt = img[i] - 126;
+      val = img[i + 1];
+      i += 2;
+    }
+
+    if (cnt > total - pos)
+      return false;
+
+    while (cnt > 0)                                     // run can continue in next band
+    {
+      uint16_t col = pos % width;
+      uint16_t len = ((width - col) < cnt) ? (width - col) : cnt;
+
+      _MBED_LCD_ImageSpan(x + col, page + pos / width, src, val, len, c0, c1);
+
+      pos += len;
+      cnt -= len;
+      if (src != NULL)
+        src += len;
+    }
+  }
+
+  return true;
+}
+
+#ifndef USE_DMA_REFRESH
+/**
+ * Decode full display compressed image directly to LCD (eg. splash screen), Video RAM is not changed
+ * Literal runs are sent from image, repeated bytes from small buffer. Refresh overwrites it by changed spans
+ * Returns false when image has not size of display or is damaged
+ */
+bool MBED_LCD_StreamImageRLE(const uint8_t *img, uint16_t size)
+{
+  uint8_t buf[16];
+  uint16_t pos = 0;
+  uint16_t i = 2;
+
+  if ((img == NULL) || (size < 2) || (img[0] != _MBED_LCD_COLUMNS) || (img[1] != _MBED_LCD_LINES))
+    return false;
+
+  while (pos < _MBED_LCD_LINES * _MBED_LCD_COLUMNS)
+  {
+    const uint8_t *src = NULL;
+    uint16_t cnt;
+
+    if (i >= size)
+      return false;
+
+    if (img[i] < 0x80)                                  // literal bytes, all in image
+    {
+      cnt = img[i] + 1;
+      if (i + 1 + cnt > size)
+        return false;
+      src = &img[i + 1];
+      i += 1 + cnt;
+    }
+    else                                                // repeated byte, value in image
+    {
+      if (i + 2 > size)
+        return false;
+      cnt = img[i] - 126;
+      memset(buf, img[i + 1], sizeof(buf));
+      i += 2;
+    }
+
+    if (cnt > _MBED_LCD_LINES * _MBED_LCD_COLUMNS - pos)
+      return false;
+
+    while (cnt > 0)
+    {
+      uint16_t len = _MBED_LCD_COLUMNS - pos % _MBED_LCD_COLUMNS;
+
+      if (len > cnt)
+        len = cnt;
+      if ((src == NULL) && (len > sizeof(buf)))
+        len = sizeof(buf);
+
+      if ((pos % _MBED_LCD_COLUMNS) == 0)               // start of page, LCD shows it from head
+      {
+        MBED_LCD_set_address((pos / _MBED_LCD_COLUMNS + _MBED_LCD_CTX->lcdHead) % _MBED_LCD_RAM_PAGES, 0);
+      }
+
+      MBED_LCD_sendData((src != NULL) ? src : buf, len);
+
+      pos += len;
+      cnt -= len;
+      if (src != NULL)
+        src += len;
+    }
+  }
+
+  return true;
+}
+#endif
+
+#ifdef MBED_LCD_BAND_MODE
+/**
+ * Replay display list into bandRam for one page, clip rectangle is limited to rows of the page
+ * Drawing functions mark touched columns of the page as dirty
+ */
+static void _MBED_LCD_BandRender(uint8_t page)
+{
+  _MBED_LCD_Ctx_t *ctx = _MBED_LCD_CTX;
+
+  _MBED_LCD_CLIP_LIMIT.y0 = page * 8;
+  _MBED_LCD_CLIP_LIMIT.y1 = page * 8 + 8;
+  _MBED_LCD_CLIP = _MBED_LCD_CLIP_LIMIT;
+  ctx->clipDepth = 0;
+  memset(ctx->bandRam, ctx->bandBack, _MBED_LCD_COLUMNS);
+  ctx->dirty[page] = _MBED_LCD_SPAN_EMPTY;
+  if (ctx->bandBack != 0)                               // background differs from cleared LCD
+    _MBED_LCD_MarkDirty(page, 0, _MBED_LCD_COLUMNS);
+
+  ctx->bandRender = true;
+  for (uint16_t i = 0; i < ctx->bandUsed; i += 2 + ctx->bandList[i + 1])
+  {
+    const uint8_t *arg = &ctx->bandList[i + 2];
+    _MBED_LCD_BandShape_t s;
+    _MBED_LCD_BandBitmap_t b;
+    _MBED_LCD_BandImage_t img;
+    _MBED_LCD_BandText_t t;
+
+    switch (ctx->bandList[i])
+    {
+      case _MBED_LCD_BAND_BITMAP:
+        memcpy(&b, arg, sizeof(b));
+        MBED_LCD_DrawBitmap(b.x, b.y, &b.bmp, (MBED_LCD_Rop_t)b.rop);
+        continue;
+      case _MBED_LCD_BAND_TEXT:
+        memcpy(&t, arg, sizeof(t));
+        _MBED_LCD_Text(t.font, t.x, t.y, (const char *)&arg[sizeof(t)], ctx->bandList[i + 1] - sizeof(t));
+        continue;
+      case _MBED_LCD_BAND_IMAGE:
+        memcpy(&img, arg, sizeof(img));
+        MBED_LCD_DrawImageRLE(img.x, img.page, img.img, img.size);
+        continue;
+      case _MBED_LCD_BAND_CLIP_POP:
+        MBED_LCD_PopClip();
+        continue;
+      case _MBED_LCD_BAND_CLIP_RESET:
+        MBED_LCD_ResetClip();
+        continue;
+      default:
+        break;
+    }
+
+    memcpy(&s, arg, sizeof(s));                         // list is byte aligned
+    switch (ctx->bandList[i])
+    {
+      case _MBED_LCD_BAND_PIXEL:       MBED_LCD_PutPixel(s.a, s.b, s.color); break;
+      case _MBED_LCD_BAND_LINE:        MBED_LCD_DrawLine(s.a, s.b, s.c, s.d, s.color); break;
+      case _MBED_LCD_BAND_RECT:        MBED_LCD_DrawRect(s.a, s.b, s.c, s.d, s.color); break;
+      case _MBED_LCD_BAND_FILL_RECT:   MBED_LCD_FillRect(s.a, s.b, s.c, s.d, s.color); break;
+      case _MBED_LCD_BAND_INVERT_RECT: MBED_LCD_InvertRect(s.a, s.b, s.c, s.d); break;
+      case _MBED_LCD_BAND_CIRCLE:      MBED_LCD_DrawCircle(s.a, s.b, s.c, s.color); break;
+      case _MBED_LCD_BAND_FILL_CIRCLE: MBED_LCD_FillCircle(s.a, s.b, s.c, s.color); break;
+      case _MBED_LCD_BAND_CLIP_SET:    MBED_LCD_SetClip(s.a, s.b, s.c, s.d); break;
+      case _MBED_LCD_BAND_CLIP_PUSH:   MBED_LCD_PushClip(s.a, s.b, s.c, s.d); break;
+      default:
+        break;
+    }
+  }
+  ctx->bandRender = false;
+
+  _MBED_LCD_CLIP_LIMIT.y0 = 0;
+  _MBED_LCD_CLIP_LIMIT.y1 = _MBED_LCD_ROWS;
+  _MBED_LCD_CLIP = _MBED_LCD_CLIP_LIMIT;
+}
+
+/**
+ * True when some drawing since MBED_LCD_InitVideoRam() did not fit to display list (MBED_LCD_BAND_LIST)
+ */
+bool MBED_LCD_BandListOverflow(void)
+{
+  return _MBED_LCD_CTX->bandOverflow;
+}
+#endif
+
+/**
+ * Area for refresh - manually or via Timer+DMA
+ */
+
+static void _MBED_LCD_frames_done(uint32_t seq)        ///< Published frames up to seq are on LCD, notify waiting side
+{
+  _MBED_LCD_Ctx_t *ctx = _MBED_LCD_CTX;
+
+  if (ctx->doneSeq != seq)
+  {
+    ctx->doneSeq = seq;
+    if (ctx->frameDone != NULL)
+      ctx->frameDone();
+  }
+
+  MBED_LCD_OS_SIGNAL();
+}
+
+static void _MBED_LCD_refresh_release(void)            ///< End of refresh (sent or nothing to send), Video RAM is free
+{
+  _MBED_LCD_unclaim_refresh();
+  _MBED_LCD_frames_done(_MBED_LCD_CTX->refreshSeq);
+}
+
+static void _MBED_LCD_refresh_done(void)               ///< End of transfer, Video RAM is free for next refresh
+{
+  _MBED_LCD_Ctx_t *ctx = _MBED_LCD_CTX;
+
+  _MBED_LCD_TimeAdd(&ctx->timeRefresh, _MBED_LCD_Now() - ctx->refreshStartTime);
+  ctx->refreshCompleted++;
+  _MBED_LCD_refresh_release();
+}
+
+#ifdef USE_DMA_REFRESH
+static bool _MBED_LCD_is_pending(void)                  ///< Any change not sent yet ?
+{
+  _MBED_LCD_Ctx_t *ctx = _MBED_LCD_CTX;
+
+  if (_MBED_LCD_FRONT_HEAD(ctx) != ctx->lcdHead)        // scroll
+    return true;
+
+  for (uint8_t r = 0; r < _MBED_LCD_LINES; r++)
+  {
+    uint16_t span = _MBED_LCD_SEND(ctx)[r];
+
+    if (_MBED_LCD_SPAN_FROM(span) < _MBED_LCD_SPAN_TO(span))
+      return true;
+  }
+
+  return false;
+}
+
+#ifdef MBED_LCD_HOST
+static void _MBED_LCD_dma_start(const uint8_t *buf, uint16_t len, bool a0)  ///< Emulated transfer, ends in MBED_LCD_HostRun()
+{
+  _MBED_LCD_CTX->sentBytes += len;
+  MBED_LCD_HostDmaStart(_MBED_LCD_INDEX, buf, len, a0);
+}
+#else
+#define _MBED_LCD_DMA_FLAGS   (DMA_LIFCR_CFEIF0 | DMA_LIFCR_CDMEIF0 | DMA_LIFCR_CTEIF0 | DMA_LIFCR_CHTIF0 | DMA_LIFCR_CTCIF0)  ///< Of stream 0, shifted for others
+
+static inline void _MBED_LCD_dma_clear(const _MBED_LCD_Hw_t *hw)   ///< Clear all flags of both streams (only write 1 available)
+{
+  _MBED_LCD_DMA_IFCR(hw->dma, hw->txStream) = _MBED_LCD_DMA_FLAGS << _MBED_LCD_DMA_SHIFT(hw->txStream);
+  _MBED_LCD_DMA_IFCR(hw->dma, hw->rxStream) = _MBED_LCD_DMA_FLAGS << _MBED_LCD_DMA_SHIFT(hw->rxStream);
+}
+
+/**
+ * Start one part of transfer - TX by DMA from buffer, RX to dummy byte by second stream (shield: DMA2 Stream3 and 0, channel 3)
+ * Called only when SPI is idle (previous RX complete), nothing is waiting for the SPI
+ */
+static void _MBED_LCD_dma_start(const uint8_t *buf, uint16_t len, bool a0)
+{
+  _MBED_LCD_Ctx_t *ctx = _MBED_LCD_CTX;
+  const _MBED_LCD_Hw_t *hw = _MBED_LCD_HW(_MBED_LCD_INDEX);
+  DMA_Stream_TypeDef *tx = _MBED_LCD_DMA_STREAM(hw->dma, hw->txStream);
+  DMA_Stream_TypeDef *rx = _MBED_LCD_DMA_STREAM(hw->dma, hw->rxStream);
+
+  tx->CR &= ~DMA_SxCR_EN;
+  rx->CR &= ~DMA_SxCR_EN;
+  hw->spi->CR2 &= ~(SPI_CR2_TXDMAEN | SPI_CR2_RXDMAEN);
+
+  // everytime is needed to clear all including errors, sometimes was set FEIFx ??
+  _MBED_LCD_dma_clear(hw);
+
+  (void)hw->spi->DR;                                    // drop old RX byte and OVR from blocking sends (read DR, SR)
+  (void)hw->spi->SR;
+
+  BB_REG(hw->a0Port->ODR, hw->a0Pin) = a0 ? 1 : 0;
+  BB_REG(hw->csnPort->ODR, hw->csnPin) = 0;           // CS stays active until SPI is idle
+
+  rx->CR = 0
+    | hw->channel * DMA_SxCR_CHSEL_0  // channel of SPI requests
+    | DMA_SxCR_TCIE   // 00 = peripheral to mem, without MINC, irq "complete" = last byte shifted out
+    ;
+  rx->PAR = (uint32_t)&(hw->spi->DR);                   // SRC
+  rx->M0AR = (uint32_t)&ctx->spiDummy;                  // DEST
+  rx->NDTR = len;
+
+  tx->CR = 0
+    | hw->channel * DMA_SxCR_CHSEL_0
+    | DMA_SxCR_DIR_0  // 01 = mem to peripheral = DMA_SxM0AR to DMA_SxPAR
+    | DMA_SxCR_MINC   // without irq, end is signaled by RX
+    ;
+  tx->PAR = (uint32_t)&(hw->spi->DR);                   // DEST
+  tx->M0AR = (uint32_t)buf;                             // SRC
+  tx->NDTR = len;
+  ctx->sentBytes += len;
+
+  hw->spi->CR2 |= SPI_CR2_RXDMAEN;                      // RX first, see RM
+  rx->CR |= DMA_SxCR_EN;
+  tx->CR |= DMA_SxCR_EN;
+  hw->spi->CR2 |= SPI_CR2_TXDMAEN;                      // go
+}
+#endif
+
+/**
+ * Refresh and command state machine - start next part of transfer, or stop when nothing is left
+ * Refresh sends address commands and changed span of each page, queued commands go after refresh
+ * Called from VideoRam2LCD, refresh timer and RX DMA "complete" interrupt
+ */
+static void _MBED_LCD_spi_next(void)
+{
+  _MBED_LCD_Ctx_t *ctx = _MBED_LCD_CTX;
+
+  switch (ctx->spiState)
+  {
+    case _MBED_LCD_SPI_PAGE_CMD:                        // address is set, send data of page
+      {
+        uint8_t from = ctx->refreshFrom[ctx->refreshDMAStage];
+        uint8_t to = ctx->refreshTo[ctx->refreshDMAStage];
+
+        ctx->spiState = _MBED_LCD_SPI_PAGE_DATA;
+        _MBED_LCD_PROF_ADD(spiData, to - from);
+        _MBED_LCD_dma_start(_MBED_LCD_SendSpan(ctx->refreshDMAStage, from, to), to - from, true);
+      }
+      return;
+
+    case _MBED_LCD_SPI_ASYNC:                           // request is sent, free its slot before callback
+      {
+        MBED_LCD_Callback_t done = ctx->cmdQueue[ctx->cmdTail].done;
+
+        ctx->cmdTail = (ctx->cmdTail + 1) % MBED_LCD_CMD_QUEUE;
+        if (done != NULL)
+          done();
+      }
+      break;
+
+    default:
+      break;
+  }
+
+  if (ctx->refreshInProgress && (ctx->spiState != _MBED_LCD_SPI_ASYNC)) // page data sent or refresh just started (not swap)
+  {
+    do                              // skip pages without change
+    {
+      ctx->refreshDMAStage++;
+    } while ((ctx->refreshDMAStage < _MBED_LCD_LINES) && (ctx->refreshFrom[ctx->refreshDMAStage] >= ctx->refreshTo[ctx->refreshDMAStage]));
+
+    if (ctx->refreshDMAStage < _MBED_LCD_LINES)
+    {
+      uint8_t from = ctx->refreshFrom[ctx->refreshDMAStage];
+
+      ctx->pageCmd[0] = 0xB0 | ((ctx->refreshDMAStage + ctx->refreshHead) % _MBED_LCD_RAM_PAGES); // (3) Page address set
+      ctx->pageCmd[1] = 0x10 | ((from & 0xf0) >> 4);   // (4) Column address set = upper 4 bits
+      ctx->pageCmd[2] = 0x00 | (from & 0x0f);          // (4) Column address set = lower 4 bits
+
+      ctx->spiState = _MBED_LCD_SPI_PAGE_CMD;
+      _MBED_LCD_PROF_ADD(spiCommands, sizeof(ctx->pageCmd));
+      _MBED_LCD_dma_start(ctx->pageCmd, sizeof(ctx->pageCmd), false);
+      return;
+    }
+
+    if (ctx->refreshHead != ctx->lcdHead)               // scroll after data, new lines were hidden until now
+    {
+      ctx->lcdHead = ctx->refreshHead;
+      ctx->lineCmd = 0x40 | ((ctx->refreshHead * 8) & 0x3f); // (2) Display start line set
+
+      ctx->spiState = _MBED_LCD_SPI_START_LINE;
+      _MBED_LCD_PROF_ADD(spiCommands, 1);
+      _MBED_LCD_dma_start(&ctx->lineCmd, 1, false);
+      return;
+    }
+
+    _MBED_LCD_refresh_done();
+  }
+
+  if (ctx->cmdTail != ctx->cmdHead)                     // queued commands between frames
+  {
+    ctx->spiState = _MBED_LCD_SPI_ASYNC;
+    _MBED_LCD_PROF_ADD(spiCommands, ctx->cmdQueue[ctx->cmdTail].len);
+    _MBED_LCD_dma_start(ctx->cmdQueue[ctx->cmdTail].cmd, ctx->cmdQueue[ctx->cmdTail].len, false);
+    return;
+  }
+
+  ctx->spiState = _MBED_LCD_SPI_IDLE;
+
+#ifndef MBED_LCD_HOST
+  const _MBED_LCD_Hw_t *hw = _MBED_LCD_HW(_MBED_LCD_INDEX);
+
+  _MBED_LCD_DMA_STREAM(hw->dma, hw->txStream)->CR &= ~DMA_SxCR_EN;   // stop
+  _MBED_LCD_DMA_STREAM(hw->dma, hw->rxStream)->CR &= ~(DMA_SxCR_EN | DMA_SxCR_TCIE);
+  hw->spi->CR2 &= ~(SPI_CR2_TXDMAEN | SPI_CR2_RXDMAEN);
+
+  BB_REG(hw->csnPort->ODR, hw->csnPin) = 1;           // to inactive CS
+#endif
+}
+#endif
+/**
+ * Copying content of videoRAM to LCD controller, based on SPI bulk transfer
+ * Only changed column spans of each page are sent, returns true without transfer when nothing changed
+ * With DMA the transfer reads directly from Video RAM (front buffer), without intermediate copy,
+ * address commands go by DMA too and transfer continues from interrupt (started only by refresh timer)
+ * Returns false when previous refresh or queued command is running or Video RAM is locked
+ *
+ * Duration ca 1.8ms without DMA when closk HSI 16MHz (full frame)
+ * 700us
+ */
+static bool _MBED_LCD_refresh_start(void)
+{
+  _MBED_LCD_Ctx_t *ctx = _MBED_LCD_CTX;
+
+#ifdef USE_DMA_REFRESH
+  if ((ctx->spiState != _MBED_LCD_SPI_IDLE) || (ctx->drawLock > 0) || !_MBED_LCD_claim_refresh())
+#else
+  if ((ctx->drawLock > 0) || !_MBED_LCD_claim_refresh())
+#endif
+  {
+    ctx->refreshSkipped++;
+    return false;
+  }
+
+  ctx->refreshSeq = ctx->frameSeq;
+  ctx->refreshHead = _MBED_LCD_FRONT_HEAD(ctx);
+#ifdef USE_DMA_REFRESH
+  {
+    bool changed = (ctx->refreshHead != ctx->lcdHead);  // scroll only
+
+    for (uint8_t r = 0; r < _MBED_LCD_LINES; r++)      // take snapshot, next changes goes to next refresh
+    {
+      uint16_t span = __atomic_exchange_n(&_MBED_LCD_SEND(ctx)[r], _MBED_LCD_SPAN_EMPTY, __ATOMIC_ACQUIRE);
+
+      ctx->refreshFrom[r] = _MBED_LCD_SPAN_FROM(span);
+      ctx->refreshTo[r] = _MBED_LCD_SPAN_TO(span);
+
+      if (ctx->refreshFrom[r] < ctx->refreshTo[r])
+        changed = true;
+    }
+
+    if (!changed)                                       // nothing to send, do not start DMA
+    {
+      ctx->refreshNoChange++;
+      _MBED_LCD_refresh_release();
+      return true;
+    }
+  }
+
+  ctx->refreshStarted++;
+  ctx->refreshStartTime = _MBED_LCD_Now();
+
+  ctx->refreshDMAStage = -1;                            // first changed page is found from beginning
+  _MBED_LCD_spi_next();
+#elif defined(MBED_LCD_BAND_MODE)
+  if (!ctx->bandChanged)
+  {
+    ctx->refreshNoChange++;
+    _MBED_LCD_refresh_release();
+    return true;
+  }
+
+  ctx->bandChanged = false;
+  ctx->refreshStarted++;
+  ctx->refreshStartTime = _MBED_LCD_Now();
+
+  for (uint8_t r = 0; r < _MBED_LCD_LINES; r++)
+  {
+    _MBED_LCD_BandRender(r);
+
+    uint8_t from = _MBED_LCD_SPAN_FROM(ctx->dirty[r]);  // drawn now or in previous frame (must be cleared)
+    uint8_t to = _MBED_LCD_SPAN_TO(ctx->dirty[r]);
+
+    if (ctx->bandFrom[r] < ctx->bandTo[r])
+    {
+      if (ctx->bandFrom[r] < from)
+        from = ctx->bandFrom[r];
+      if (ctx->bandTo[r] > to)
+        to = ctx->bandTo[r];
+    }
+
+    ctx->bandFrom[r] = _MBED_LCD_SPAN_FROM(ctx->dirty[r]);
+    ctx->bandTo[r] = _MBED_LCD_SPAN_TO(ctx->dirty[r]);
+
+    if (from >= to)                                     // page empty now and before
+      continue;
+
+    MBED_LCD_set_address(r, from);
+    MBED_LCD_sendData(&ctx->bandRam[from], to - from);
+  }
+
+  _MBED_LCD_refresh_done();
+#else
+  bool changed = false;
+
+  ctx->refreshStartTime = _MBED_LCD_Now();
+  if (ctx->refreshHead != ctx->lcdHead)
+  {
+    changed = true;
+    ctx->refreshStarted++;
+  }
+
+  for (uint8_t r = 0; r < _MBED_LCD_LINES; r++)
+  {
+    uint16_t span = __atomic_exchange_n(&_MBED_LCD_SEND(ctx)[r], _MBED_LCD_SPAN_EMPTY, __ATOMIC_ACQUIRE);
+    uint8_t from = _MBED_LCD_SPAN_FROM(span);           // cleared before sending, next changes are marked again
+    uint8_t to = _MBED_LCD_SPAN_TO(span);
+
+    if (from >= to)                                     // page without change
+      continue;
+
+    if (!changed)
+    {
+      changed = true;
+      ctx->refreshStarted++;
+    }
+
+    MBED_LCD_set_address((r + ctx->refreshHead) % _MBED_LCD_RAM_PAGES, from);
+
+#if 1
+    MBED_LCD_sendData(_MBED_LCD_SendSpan(r, from, to), to - from); // block operation
+#else
+    for(uint8_t x = from; x < to; x++)
+      MBED_LCD_send(_MBED_LCD_FRONT(ctx)[r][x], 1);
+#endif
+  }
+
+  if (ctx->refreshHead != ctx->lcdHead)                 // scroll after data, new lines were hidden until now
+  {
+    ctx->lcdHead = ctx->refreshHead;
+    MBED_LCD_set_start_line(ctx->refreshHead * 8);
+  }
+
+  if (changed)
+    _MBED_LCD_refresh_done();
+  else
+  {
+    ctx->refreshNoChange++;
+    _MBED_LCD_refresh_release();
+  }
+#endif
+
+  return true;
+}
+
+/**
+ * Send changed parts of Video RAM to LCD, see _MBED_LCD_refresh_start()
+ * With USE_DMA_REFRESH the transfer is started by refresh timer interrupt (it owns SPI and DMA),
+ * so the call is safe from any context; true = requested, wait by MBED_LCD_WaitFrame()
+ */
+bool MBED_LCD_VideoRam2LCD(void)
+{
+#ifdef USE_DMA_REFRESH
+  _MBED_LCD_Ctx_t *ctx = _MBED_LCD_CTX;
+
+  if (ctx->refreshInProgress || (ctx->drawLock > 0))
+  {
+    ctx->refreshSkipped++;
+    return false;
+  }
+
+  _MBED_LCD_wake_refresh();                             // next ticks, when command goes first
+  _MBED_LCD_TIMER_PEND();
+  return true;
+#else
+  return _MBED_LCD_refresh_start();
+#endif
+}
+
+/**
+ * Send sequence of commands (A0 = 0) to LCD, done is called after last byte (may be NULL)
+ * With USE_DMA_REFRESH the request is queued and sent by interrupts between refresh transfers,
+ * done is called from interrupt. Otherwise commands are sent immediately (blocking)
+ * Returns false when queue is full or sequence is longer than MBED_LCD_CMD_MAX_LEN
+ */
+bool MBED_LCD_SendCommandsAsync(const uint8_t *cmds, uint8_t len, MBED_LCD_Callback_t done)
+{
+  if ((len == 0) || (len > MBED_LCD_CMD_MAX_LEN))
+    return false;
+
+#ifdef USE_DMA_REFRESH
+  _MBED_LCD_Ctx_t *ctx = _MBED_LCD_CTX;
+  uint8_t next = (ctx->cmdHead + 1) % MBED_LCD_CMD_QUEUE;
+
+  if (next == ctx->cmdTail)                             // full
+    return false;
+
+  memcpy(ctx->cmdQueue[ctx->cmdHead].cmd, cmds, len);
+  ctx->cmdQueue[ctx->cmdHead].len = len;
+  ctx->cmdQueue[ctx->cmdHead].done = done;
+  ctx->cmdHead = next;                                  // publish after request is complete
+
+  _MBED_LCD_wake_refresh();                             // postponed refresh needs next tick
+  _MBED_LCD_TIMER_PEND();                               // refresh timer interrupt starts it when SPI is idle
+#else
+  MBED_LCD_sendCommands(cmds, len);
+
+  if (done != NULL)
+    done();
+#endif
+
+  return true;
+}
+
+/**
+ * Contrast = electronic volume 0 .. 63
+ */
+bool MBED_LCD_SetContrastAsync(uint8_t value, MBED_LCD_Callback_t done)
+{
+  uint8_t cmds[2] = { 0x81, value & 0x3f };             // (18) Electronic volume mode set + register
+
+  return MBED_LCD_SendCommandsAsync(cmds, sizeof(cmds), done);
+}
+
+/**
+ * Inverted display - pixel 1 is white, Video RAM is not changed
+ */
+bool MBED_LCD_SetInvertAsync(bool invert, MBED_LCD_Callback_t done)
+{
+  uint8_t cmd = invert ? 0xA7 : 0xA6;                   // (9) Display normal / reverse
+
+  return MBED_LCD_SendCommandsAsync(&cmd, 1, done);
+}
+
+/**
+ * Display on, or power save mode (display off + all points on, see DS)
+ */
+bool MBED_LCD_SetPowerAsync(bool on, MBED_LCD_Callback_t done)
+{
+  uint8_t cmds[2];
+
+  if (on)
+  {
+    cmds[0] = 0xA4;                                     // (10) Display all points = normal
+    cmds[1] = 0xAF;                                     // (1) Display ON
+  }
+  else
+  {
+    cmds[0] = 0xAE;                                     // (1) Display OFF
+    cmds[1] = 0xA5;                                     // (10) Display all points ON = power saver
+  }
+
+  return MBED_LCD_SendCommandsAsync(cmds, sizeof(cmds), done);
+}
+
+#ifdef USE_DMA_REFRESH
+/**
+ * SPI RX "complete" - last byte of part is shifted out, continue without waiting for SPI
+ */
+static void _MBED_LCD_dma_irq(uint8_t index)
+{
+  _MBED_LCD_ENTER(index);
+  uint32_t t0 = _MBED_LCD_Now();
+#ifdef MBED_LCD_HOST
+  _MBED_LCD_spi_next();                                 // emulated transfer is complete
+#else
+  const _MBED_LCD_Hw_t *hw = _MBED_LCD_HW(index);
+
+  if (_MBED_LCD_DMA_ISR(hw->dma, hw->rxStream) & (DMA_LISR_TCIF0 << _MBED_LCD_DMA_SHIFT(hw->rxStream)))
+  {
+    _MBED_LCD_dma_clear(hw);
+    _MBED_LCD_spi_next();
+  }
+#endif
+
+  _MBED_LCD_TimeAdd(&_MBED_LCD_CTX->timeDmaIsr, _MBED_LCD_Now() - t0);
+  _MBED_LCD_LEAVE();
+}
+
+#ifdef MBED_LCD_HOST
+void MBED_LCD_HostDmaIRQHandler(uint8_t port)
+{
+  _MBED_LCD_dma_irq(port);
+}
+#else
+void _MBED_LCD_DMA_RX_IRQHandler(void)
+{
+  _MBED_LCD_dma_irq(0);
+}
+
+#if (MBED_LCD_INSTANCES > 1)
+void MBED_LCD_HW1_DMA_IRQHandler(void)
+{
+  _MBED_LCD_dma_irq(1);
+}
+#endif
+
+#if (MBED_LCD_INSTANCES > 2)
+void MBED_LCD_HW2_DMA_IRQHandler(void)
+{
+  _MBED_LCD_dma_irq(2);
+}
+#endif
+
+#if (MBED_LCD_INSTANCES > 3)
+void MBED_LCD_HW3_DMA_IRQHandler(void)
+{
+  _MBED_LCD_dma_irq(3);
+}
+#endif
+#endif
+#endif
+
+#ifdef USE_DMA_REFRESH
+/**
+ * Refresh timer - starts transfer only when something was changed, changes between ticks
+ * goes together to one frame. Without change the timer stops, next drawing starts it again
+ * Queued commands are started here too, when SPI is idle
+ */
+static bool _MBED_LCD_tick(void)                       ///< Refresh tick of selected display, false = timer is not needed
+{
+  _MBED_LCD_Ctx_t *ctx = _MBED_LCD_CTX;
+
+  if ((ctx->spiState == _MBED_LCD_SPI_IDLE) && (ctx->cmdTail != ctx->cmdHead) && !ctx->refreshInProgress)
+    _MBED_LCD_spi_next();                               // command first, refresh at next tick
+  else if (ctx->drawLock > 0)                           // frame is drawn, End or Unlock starts refresh
+    return false;
+  else if (_MBED_LCD_is_pending())
+    _MBED_LCD_refresh_start();                          // false = skipped (frame ready, SPI busy), counted in statistics
+  else if (!ctx->refreshInProgress)
+  {
+    _MBED_LCD_frames_done(ctx->frameSeq);               // all published frames are on LCD
+    return false;
+  }
+
+  return true;
+}
+
+void _MBED_LCD_TIM_IRQHandler(void)
+{
+  uint32_t t0 = _MBED_LCD_Now();
+  bool busy = false;
+
+  _MBED_LCD_TIMER_ACK();
+
+  for (uint8_t i = 0; i < MBED_LCD_INSTANCES; i++)     // each display has own transfer, all start at the same tick
+  {
+    _MBED_LCD_ENTER(i);
+    if (_MBED_LCD_tick())
+      busy = true;
+    _MBED_LCD_LEAVE();
+  }
+
+  if (busy)                                             // also when started by pending, timer must not stay stopped
+  {
+    _refreshIdle = false;
+    _MBED_LCD_TIMER_RUN();
+  }
+  else
+  {
+    _MBED_LCD_TIMER_STOP();                             // nothing to send, stop until next change
+    _refreshIdle = true;
+  }
+
+  _MBED_LCD_TimeAdd(&m_timeTimerIsr, _MBED_LCD_Now() - t0);
+}
+#endif
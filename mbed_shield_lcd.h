@@ -1,46 +1,315 @@
-/*
- * lcd.h
- *
- *  Created on: 17. 9. 2017
- *      Author: weiss_000
- */
-
-#ifndef MBED_SHIELD_LCD_H_
-#define MBED_SHIELD_LCD_H_
-
-/**
- * Preparation global symbols - bool and integer types
- */
-#ifndef bool
-#include <stdbool.h>
-#endif
-
-#ifndef uint8_t
-#include <stdint.h>
-#endif
-
-void MBED_LCD_InitVideoRam(uint8_t val);      ///< Fill all Video RAM by value (bytes = columns, MSB on top)
-bool MBED_LCD_VideoRam2LCD();                 ///< Copy Video RAM content to LCD using SPI
-
-bool MBED_LCD_init(void);                     ///< singal initialization, RESET, first init commands
-
-uint8_t MBED_LCD_GetColumns(void);            ///< Number of pixels horizontaly
-uint8_t MBED_LCD_GetRows(void);               ///< Number of pixels verticaly
-uint8_t MBED_LCD_GetLines(void);              ///< Number of text lines (hor. pix / 8)
-uint8_t MBED_LCD_GetCharPerLine(void);        ///< Number of characters (vert. pix / 8)
-
-bool MBED_LCD_WriteCharXY(char c, uint8_t x, uint8_t y);          ///< Write 8x8 char to position counted in pixels
-bool MBED_LCD_WriteCharCR(char c, uint8_t col, uint8_t row);      ///< Write 8x8 char to position counted in chars
-bool MBED_LCD_WriteStringXY(char *cp, uint8_t x, uint8_t y);      ///< Write sequence of8x8 chars to position counted in pixels
-bool MBED_LCD_WriteStringCR(char *cp, uint8_t col, uint8_t row);  ///< Write sequence of8x8 chars to position counted in chars
-void MBED_LCD_PutPixel(uint8_t x, uint8_t y, bool black);         ///< Put pixel - 1 = black, 0 = white (background)
-
-void MBED_LCD_DrawLine(int x0, int y0, int x1, int y1, bool color);
-void MBED_LCD_DrawRect(int x, int y, int w, int h, bool color);
-void MBED_LCD_FillRect(int x, int y, int w, int h, bool color);
-void MBED_LCD_DrawCircle(int centerX, int centerY, int radius, bool colorSet);
-void MBED_LCD_FillCircle(int x0, int y0, int radius, bool color);
-
-void MBED_LCD_DrawSpriteMono8(int x, int y, uint8_t *data, int rows, bool color);
-
-#endif /* MBED_SHIELD_LCD_H_ */
+/*
+ * lcd.h
+ *
+ *  Created on: 17. 9. 2017
+ *      Author: weiss_000
+ */
+
+#ifndef MBED_SHIELD_LCD_H_
+#define MBED_SHIELD_LCD_H_
+
+/**
+ * Preparation global symbols - bool and integer types
+ */
+#ifndef bool
+#include <stdbool.h>
+#endif
+
+#ifndef uint8_t
+#include <stdint.h>
+#endif
+
+void MBED_LCD_InitVideoRam(uint8_t val);      ///< Fill all Video RAM by value (bytes = columns, MSB on top)
+bool MBED_LCD_VideoRam2LCD();                 ///< Copy changed parts of Video RAM to LCD using SPI
+void MBED_LCD_Invalidate(void);               ///< Mark all Video RAM as changed, next refresh sends everything
+uint32_t MBED_LCD_GetSentBytes(void);         ///< Count of bytes sent to LCD (commands + data)
+void MBED_LCD_ClearSentBytes(void);           ///< Reset counter of sent bytes
+bool MBED_LCD_SetFrameRate(uint16_t fps);     ///< Auto-refresh rate 1 .. 1000 fps (USE_DMA_REFRESH)
+void MBED_LCD_BeginFrame(void);               ///< Start frame, refresh never sends half-drawn frame
+void MBED_LCD_EndFrame(bool wait);            ///< Publish frame to refresh now, wait = until it is on LCD
+void MBED_LCD_LockVideoRam(void);             ///< Block refresh while drawing, waits for running refresh
+void MBED_LCD_UnlockVideoRam(void);           ///< Allow refresh again
+#ifdef MBED_LCD_DOUBLE_BUFFER
+bool MBED_LCD_SwapBuffers(void);              ///< Publish back buffer to refresh, false when refresh is running
+#endif
+
+/**
+ * Asynchronous commands - with USE_DMA_REFRESH queued and sent by interrupts between refresh transfers,
+ * callback is called from interrupt. Without DMA sent immediately, callback is called before return
+ */
+typedef void (*MBED_LCD_Callback_t)(void);
+
+#define MBED_LCD_CMD_MAX_LEN  4               ///< Max. bytes of one command sequence
+
+bool MBED_LCD_SendCommandsAsync(const uint8_t *cmds, uint8_t len, MBED_LCD_Callback_t done);  ///< Queue raw commands, false = queue full
+bool MBED_LCD_SetContrastAsync(uint8_t value, MBED_LCD_Callback_t done);  ///< Contrast 0 .. 63
+bool MBED_LCD_SetInvertAsync(bool invert, MBED_LCD_Callback_t done);      ///< Reverse display (white on black)
+bool MBED_LCD_SetPowerAsync(bool on, MBED_LCD_Callback_t done);           ///< Display on, or power save
+
+/**
+ * Frame handoff - frames published by MBED_LCD_EndFrame() are numbered, refresh reports the last one on LCD
+ * RTOS hooks MBED_LCD_OS_xxx (see mbed_shield_lcd_config.h) lock frames and block waiting tasks
+ */
+void MBED_LCD_WaitFrame(void);                ///< Wait until all published frames are on LCD
+void MBED_LCD_SetFrameCallback(MBED_LCD_Callback_t done);   ///< Called when frame is on LCD (from interrupt with DMA), NULL = none
+
+bool MBED_LCD_init(void);                     ///< singal initialization, RESET, first init commands
+bool MBED_LCD_Select(uint8_t index);          ///< Following calls go to display index (MBED_LCD_INSTANCES)
+uint8_t MBED_LCD_GetSelected(void);           ///< Index of selected display
+
+uint8_t MBED_LCD_GetColumns(void);            ///< Number of pixels horizontaly
+uint8_t MBED_LCD_GetRows(void);               ///< Number of pixels verticaly
+uint8_t MBED_LCD_GetLines(void);              ///< Number of text lines (hor. pix / 8)
+uint8_t MBED_LCD_GetCharPerLine(void);        ///< Number of characters (vert. pix / 8)
+
+/**
+ * Font - glyphs in page format (byte = column, LSB on top, band by band), stored in flash (const)
+ * Any height (6, 8, 12, 16 ...), monospaced or proportional (widths), all codes or subset (codes)
+ * Made from BDF by tools/mbed_lcd_font, which can keep only characters used by application
+ */
+typedef struct
+{
+  uint8_t height;                             ///< Rows of glyph
+  uint8_t width;                              ///< Columns of monospaced glyph (widest glyph of proportional font)
+  uint8_t spacing;                            ///< Empty columns drawn after each glyph
+  uint8_t missing;                            ///< Index of glyph drawn for code not in font
+  uint8_t first;                              ///< Code of glyph 0, when codes == NULL
+  uint16_t count;                             ///< Number of glyphs
+  const uint8_t *codes;                       ///< Ascending codes of glyphs (subset), NULL = first .. first + count - 1
+  const uint8_t *widths;                      ///< Columns of each glyph, NULL = monospaced
+  const uint16_t *offsets;                    ///< Start of each glyph in data, NULL = index * width * bands
+  const uint8_t *data;                        ///< (height + 7) / 8 bands of glyph width each
+} MBED_LCD_Font_t;
+
+extern const MBED_LCD_Font_t MBED_LCD_Font8x8;  ///< Default font, ASCII 0 .. 127
+extern const MBED_LCD_Font_t MBED_LCD_FontMini6; ///< Proportional 6 rows, ASCII 32 .. 126 - defined by font_mini6.h
+
+void MBED_LCD_SetFont(const MBED_LCD_Font_t *font);               ///< Font of XY text functions, NULL = MBED_LCD_Font8x8
+const MBED_LCD_Font_t *MBED_LCD_GetFont(void);                    ///< Selected font
+int MBED_LCD_DrawText(int x, int y, const char *cp);              ///< Text in selected font, returns x behind it
+int MBED_LCD_GetTextWidth(const char *cp);                        ///< Width of text in selected font (pixels)
+
+/**
+ * Glyph cache (global symbol MBED_LCD_GLYPH_CACHE = bytes of RAM) - glyphs pre-shifted for text at y not aligned to 8
+ * Keyed by glyph and y % 8, least recently used is replaced, glyphs up to MBED_LCD_GLYPH_CACHE_WIDTH (default 8) columns
+ */
+#ifdef MBED_LCD_GLYPH_CACHE
+typedef struct
+{
+  uint32_t hits;                              ///< Glyph band found pre-shifted
+  uint32_t misses;                            ///< Glyph band shifted and stored
+  uint32_t evictions;                         ///< Stored band replaced other one
+  uint16_t entries;                           ///< Capacity in glyph bands
+} MBED_LCD_GlyphCacheStats_t;
+
+void MBED_LCD_GetGlyphCacheStats(MBED_LCD_GlyphCacheStats_t *stats);  ///< Copy of counters, size of cache
+void MBED_LCD_ResetGlyphCache(void);                              ///< Drop cached glyphs and counters
+#endif
+
+bool MBED_LCD_WriteCharXY(char c, uint8_t x, uint8_t y);          ///< Write char of selected font to position counted in pixels
+bool MBED_LCD_WriteCharCR(char c, uint8_t col, uint8_t row);      ///< Write 8x8 char to position counted in chars
+bool MBED_LCD_WriteStringXY(char *cp, uint8_t x, uint8_t y);      ///< Write chars of selected font to position counted in pixels
+bool MBED_LCD_WriteStringCR(char *cp, uint8_t col, uint8_t row);  ///< Write sequence of8x8 chars to position counted in chars
+void MBED_LCD_PutPixel(uint8_t x, uint8_t y, bool black);         ///< Put pixel - 1 = black, 0 = white (background)
+
+/**
+ * Numbers without printf - flags of MBED_LCD_FormatNumber() and fields (can be combined)
+ */
+typedef enum
+{
+  MBED_LCD_FMT_HEX = 0x01,                    ///< Hexadecimal digits 0 .. F, value is unsigned, decimals are ignored
+  MBED_LCD_FMT_ZERO = 0x02,                   ///< Pad by zeros between sign and digits instead of spaces before
+  MBED_LCD_FMT_PLUS = 0x04,                   ///< Sign '+' for positive value
+  MBED_LCD_FMT_LEFT = 0x08,                   ///< Left aligned, spaces after value
+} MBED_LCD_FmtFlags_t;
+
+#define MBED_LCD_FMT_MAX      12              ///< Max. characters of number without padding (sign, 10 digits, point)
+
+int MBED_LCD_FormatNumber(char *buf, int32_t value, uint8_t width, uint8_t decimals, uint8_t flags);  ///< Returns length, '#' when too long
+
+/**
+ * Field - number or text at fixed place, only characters changed since previous value are drawn
+ * Allocated by application (static or on stack of drawing task), each character has cell of widest glyph of font
+ */
+#define MBED_LCD_FIELD_CHARS  16              ///< Max. characters of field
+
+typedef struct
+{
+  int16_t x, y;                               ///< Top left corner
+  uint8_t width;                              ///< Characters, value is right aligned (MBED_LCD_FMT_LEFT = left)
+  uint8_t decimals;                           ///< Digits after decimal point of fixed point value
+  uint8_t flags;                              ///< MBED_LCD_FmtFlags_t
+  bool valid;                                 ///< Text is on display, false = next value draws all
+  const MBED_LCD_Font_t *font;                ///< Selected font at MBED_LCD_FieldInit()
+  char text[MBED_LCD_FIELD_CHARS];            ///< Characters on display
+} MBED_LCD_Field_t;
+
+#ifndef MBED_LCD_BAND_MODE                                        // needs content of previous frame
+void MBED_LCD_FieldInit(MBED_LCD_Field_t *f, int x, int y, uint8_t width, uint8_t decimals, uint8_t flags);  ///< Place and format, draws nothing
+void MBED_LCD_FieldSetNumber(MBED_LCD_Field_t *f, int32_t value);   ///< Draw changed digits of formatted value
+void MBED_LCD_FieldSetText(MBED_LCD_Field_t *f, const char *cp);    ///< Draw changed characters of aligned text
+void MBED_LCD_FieldInvalidate(MBED_LCD_Field_t *f);                ///< Next value draws whole field
+#endif
+
+#ifndef MBED_LCD_BAND_MODE                                        // content of previous frames is not kept
+void MBED_LCD_ScrollUpLines(uint8_t lines);                       ///< Hardware scroll by text lines, bottom is cleared
+void MBED_LCD_ConsoleClear(void);                                 ///< Clear display, cursor to top left
+void MBED_LCD_ConsolePutChar(char c);                             ///< Console output - \n, \r, \t, wrap, scroll
+void MBED_LCD_ConsoleWrite(const char *cp);                       ///< Console output of string
+#else
+bool MBED_LCD_BandListOverflow(void);                             ///< Some drawing did not fit to display list
+#endif
+
+void MBED_LCD_DrawLine(int x0, int y0, int x1, int y1, bool color);
+void MBED_LCD_DrawRect(int x, int y, int w, int h, bool color);
+void MBED_LCD_FillRect(int x, int y, int w, int h, bool color);
+void MBED_LCD_DrawCircle(int centerX, int centerY, int radius, bool colorSet);
+void MBED_LCD_FillCircle(int x0, int y0, int radius, bool color);
+
+void MBED_LCD_DrawSpriteMono8(int x, int y, uint8_t *data, int rows, bool color);
+
+/**
+ * Monochrome bitmap for MBED_LCD_DrawBitmap(), bit 1 = black pixel
+ */
+typedef enum
+{
+  MBED_LCD_BMP_PAGES = 0,                     ///< Like Video RAM - bands of 8 rows, byte = column, LSB on top
+  MBED_LCD_BMP_ROWS,                          ///< Row by row, (width + 7) / 8 bytes per row, MSB on left
+} MBED_LCD_BmpFormat_t;
+
+typedef enum
+{
+  MBED_LCD_ROP_COPY = 0,                      ///< Pixel = bitmap
+  MBED_LCD_ROP_OR,                            ///< Set black pixels of bitmap
+  MBED_LCD_ROP_AND,                           ///< Keep only where bitmap is black
+  MBED_LCD_ROP_XOR,                           ///< Invert where bitmap is black (cursors)
+  MBED_LCD_ROP_ANDNOT,                        ///< Clear black pixels of bitmap
+} MBED_LCD_Rop_t;
+
+typedef struct
+{
+  uint16_t width;                             ///< Pixels
+  uint16_t height;
+  MBED_LCD_BmpFormat_t format;
+  const uint8_t *data;
+  const uint8_t *mask;                        ///< Same format and size, 0 = transparent pixel, NULL = none
+} MBED_LCD_Bitmap_t;
+
+void MBED_LCD_DrawBitmap(int x, int y, const MBED_LCD_Bitmap_t *bmp, MBED_LCD_Rop_t rop);  ///< Draw bitmap with raster operation, clipped
+
+/**
+ * Compressed image - page format (byte = column, LSB on top, band by band) packed by runs, see tools/
+ * img[0] = width, img[1] = pages, then blocks: n = 0..127 - n + 1 literal bytes follow,
+ * n = 128..255 - next byte is repeated n - 126 times. Runs can continue to next band
+ */
+bool MBED_LCD_DrawImageRLE(int x, int page, const uint8_t *img, uint16_t size);  ///< Decode to Video RAM, clipped
+#ifndef USE_DMA_REFRESH
+bool MBED_LCD_StreamImageRLE(const uint8_t *img, uint16_t size);  ///< Full display image directly to LCD (splash)
+#endif
+
+/**
+ * Bulk operations on Video RAM - word wide, clipped by clip rectangle
+ * Saved rectangle is page format bitmap, MBED_LCD_RECT_SIZE(w, h) bytes
+ */
+#define MBED_LCD_RECT_SIZE(w, h)   ((w) * (((h) + 7) / 8))
+void MBED_LCD_InvertRect(int x, int y, int w, int h);              ///< Invert pixels (highlight bar)
+#ifndef MBED_LCD_BAND_MODE                                          // need content of whole Video RAM
+void MBED_LCD_CopyRect(int sx, int sy, int w, int h, int dx, int dy);  ///< Copy rectangle, areas can overlap
+void MBED_LCD_Scroll(int dx, int dy, bool color);                 ///< Move content of clip rectangle, fill uncovered part
+uint16_t MBED_LCD_SaveRect(int x, int y, int w, int h, uint8_t *buf);  ///< Rectangle to buffer, returns count of bytes
+#endif
+void MBED_LCD_RestoreRect(int x, int y, int w, int h, const uint8_t *buf);   ///< Draw saved rectangle back
+
+/**
+ * Strip chart - ring of samples given by application, new sample moves chart left by one column and draws only it
+ * Column is range lo .. hi (min/max envelope) or single value, connected with previous column by vertical span
+ */
+typedef struct
+{
+  int16_t lo, hi;                             ///< Range of values in column (lo == hi for single sample)
+} MBED_LCD_ChartSample_t;
+
+typedef struct
+{
+  int16_t x, y;                               ///< Top left corner of chart area
+  uint8_t w, h;                               ///< Size, one column per sample
+  int16_t min, max;                           ///< Values of bottom and top row
+  bool autoscale;                             ///< Range follows visible samples, chart is redrawn when it changes
+  uint8_t head;                               ///< Index of next sample in buf
+  uint8_t count;                              ///< Visible samples
+  int16_t dataLo, dataHi;                     ///< Range of visible samples (autoscale)
+  MBED_LCD_ChartSample_t *buf;                ///< Ring of w samples
+} MBED_LCD_Chart_t;
+
+#ifndef MBED_LCD_BAND_MODE                                          // chart moves content of previous frame
+void MBED_LCD_ChartInit(MBED_LCD_Chart_t *c, int x, int y, uint8_t w, uint8_t h, MBED_LCD_ChartSample_t *buf,
+    int16_t min, int16_t max, bool autoscale);                     ///< Place, ring of w samples, first range; clears area
+void MBED_LCD_ChartAdd(MBED_LCD_Chart_t *c, int16_t value);       ///< New sample, chart moves by one column
+void MBED_LCD_ChartAddMinMax(MBED_LCD_Chart_t *c, int16_t lo, int16_t hi);   ///< New column with min/max envelope
+void MBED_LCD_ChartSetRange(MBED_LCD_Chart_t *c, int16_t min, int16_t max);  ///< Fixed range, autoscale off, redraw
+void MBED_LCD_ChartRedraw(MBED_LCD_Chart_t *c);                   ///< Draw whole chart from samples
+#endif
+
+/**
+ * Overlay (global symbol MBED_LCD_OVERLAY) - items combined with Video RAM only while sending to LCD
+ * Cursor or blinking field moves without redrawing background, MBED_LCD_OVERLAY_ITEMS items (default 4)
+ */
+#ifdef MBED_LCD_OVERLAY
+bool MBED_LCD_OverlayRect(uint8_t id, int x, int y, int w, int h, MBED_LCD_Rop_t rop);  ///< Item is solid rectangle, shown
+bool MBED_LCD_OverlayBitmap(uint8_t id, int x, int y, const MBED_LCD_Bitmap_t *bmp, MBED_LCD_Rop_t rop);  ///< Item is bitmap, shown
+bool MBED_LCD_OverlayMove(uint8_t id, int x, int y);              ///< New top left corner of item
+bool MBED_LCD_OverlayShow(uint8_t id, bool visible);              ///< Show / hide item (blinking)
+#endif
+
+/**
+ * Clip rectangle - drawing functions (incl. text) write only inside it, default is whole display
+ */
+void MBED_LCD_SetClip(int x, int y, int w, int h);    ///< Set clip, limited by display
+void MBED_LCD_ResetClip(void);                        ///< Whole display, drop saved clips
+bool MBED_LCD_PushClip(int x, int y, int w, int h);   ///< Save clip and limit it by rectangle, false = stack full
+bool MBED_LCD_PopClip(void);                          ///< Restore saved clip, false = nothing saved
+
+/**
+ * Refresh statistics, durations in ticks of clock - CPU cycles (DWT) on target, MBED_LCD_SetClock() on host
+ */
+typedef struct
+{
+  uint32_t count;                             ///< Count of measured events
+  uint32_t min;
+  uint32_t avg;
+  uint32_t max;
+} MBED_LCD_Timing_t;
+
+typedef struct
+{
+  uint32_t refreshStarted;                    ///< Transfers started
+  uint32_t refreshCompleted;                  ///< Transfers finished
+  uint32_t refreshSkipped;                    ///< Changes ready, refresh refused - previous still running or Video RAM locked
+  uint32_t refreshNoChange;                   ///< Refresh without anything to send
+  uint32_t spiBytes;                          ///< Bytes sent to LCD (same as MBED_LCD_GetSentBytes)
+  MBED_LCD_Timing_t refresh;                  ///< Duration of whole transfer
+  MBED_LCD_Timing_t dmaIsr;                   ///< Duration of DMA (SPI RX) interrupt (USE_DMA_REFRESH)
+  MBED_LCD_Timing_t timerIsr;                 ///< Duration of refresh timer interrupt (USE_DMA_REFRESH)
+} MBED_LCD_Stats_t;
+
+void MBED_LCD_GetStats(MBED_LCD_Stats_t *stats);      ///< Copy of refresh statistics
+void MBED_LCD_ResetStats(void);                       ///< Clear statistics and counter of sent bytes
+void MBED_LCD_SetClock(uint32_t (*clock)(void));      ///< Free running tick counter for statistics, NULL = none
+
+/**
+ * Profiling counters, only with global symbol MBED_LCD_PROFILE (benchmarks, see bench/)
+ */
+#ifdef MBED_LCD_PROFILE
+typedef struct
+{
+  uint32_t putPixelCalls;                     ///< Calls of MBED_LCD_PutPixel
+  uint32_t fbBytes;                           ///< Bytes of Video RAM written
+  uint32_t spiCommands;                       ///< Command bytes sent to LCD
+  uint32_t spiData;                           ///< Data bytes sent to LCD
+} MBED_LCD_Profile_t;
+
+void MBED_LCD_GetProfile(MBED_LCD_Profile_t *prof);   ///< Copy of counters
+void MBED_LCD_ClearProfile(void);                     ///< Reset all counters
+#endif
+
+#endif /* MBED_SHIELD_LCD_H_ */
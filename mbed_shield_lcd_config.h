@@ -0,0 +1,230 @@
+/*
+ * mbed_shield_lcd_config.h
+ *
+ * Board configuration of LCD driver - SPI, pins, DMA streams and refresh timer
+ * Everything can be set globally, defaults are mbed shield at NUCLEO-F4xx (Arduino connector)
+ * Configuration is checked at compile time (also in host build), registers are derived from it by preprocessor
+ */
+
+#ifndef MBED_SHIELD_LCD_CONFIG_H_
+#define MBED_SHIELD_LCD_CONFIG_H_
+
+/**
+ * Platform - STM32F4 (SPI + DMA refresh) or STM32F1 (SPI only, default pin mapping)
+ * Host build checks configuration as STM32F4, if STM32F1 is not defined
+ */
+#if defined(STM32F1)
+#define _MBED_LCD_STM32F1
+#elif defined(STM32F4) || defined(MBED_LCD_HOST)
+#define _MBED_LCD_STM32F4
+#else
+#error Not supported platform (STM32F4 or STM32F1)
+#endif
+
+/**
+ * Board of display 0, porting to another board is this block
+ */
+#ifndef MBED_LCD_CFG_SPI
+#define MBED_LCD_CFG_SPI            1         ///< SPI1 .. SPI3
+#endif
+#ifndef MBED_LCD_CFG_SCK_PORT
+#define MBED_LCD_CFG_SCK_PORT       GPIOA     ///< SPI clock
+#define MBED_LCD_CFG_SCK_PIN        5
+#endif
+#ifndef MBED_LCD_CFG_MOSI_PORT
+#define MBED_LCD_CFG_MOSI_PORT      GPIOA     ///< SPI MOSI signal
+#define MBED_LCD_CFG_MOSI_PIN       7
+#endif
+#ifndef MBED_LCD_CFG_RSTN_PORT
+#define MBED_LCD_CFG_RSTN_PORT      GPIOA     ///< display RST signal, active in LO
+#define MBED_LCD_CFG_RSTN_PIN       6
+#endif
+#ifndef MBED_LCD_CFG_CSN_PORT
+#define MBED_LCD_CFG_CSN_PORT       GPIOB     ///< display CS signal, active in LO
+#define MBED_LCD_CFG_CSN_PIN        6
+#endif
+#ifndef MBED_LCD_CFG_A0_PORT
+#define MBED_LCD_CFG_A0_PORT        GPIOA     ///< display A0 signal, LO = commands, HI = data
+#define MBED_LCD_CFG_A0_PIN         8
+#endif
+
+/**
+ * DMA streams of SPI (STM32F4 only, see RM, DMA request mapping)
+ * SPI1 - DMA2 channel 3, TX stream 3 or 5, RX stream 0 or 2
+ * SPI2 - DMA1 channel 0, TX stream 4, RX stream 3
+ * SPI3 - DMA1 channel 0, TX stream 5 or 7, RX stream 0 or 2
+ */
+#if (MBED_LCD_CFG_SPI == 1)
+#ifndef MBED_LCD_CFG_DMA_TX_STREAM
+#define MBED_LCD_CFG_DMA_TX_STREAM  3
+#endif
+#ifndef MBED_LCD_CFG_DMA_RX_STREAM
+#define MBED_LCD_CFG_DMA_RX_STREAM  0
+#endif
+#elif (MBED_LCD_CFG_SPI == 2)
+#ifndef MBED_LCD_CFG_DMA_TX_STREAM
+#define MBED_LCD_CFG_DMA_TX_STREAM  4
+#endif
+#ifndef MBED_LCD_CFG_DMA_RX_STREAM
+#define MBED_LCD_CFG_DMA_RX_STREAM  3
+#endif
+#elif (MBED_LCD_CFG_SPI == 3)
+#ifndef MBED_LCD_CFG_DMA_TX_STREAM
+#define MBED_LCD_CFG_DMA_TX_STREAM  5
+#endif
+#ifndef MBED_LCD_CFG_DMA_RX_STREAM
+#define MBED_LCD_CFG_DMA_RX_STREAM  0
+#endif
+#else
+#error Invalid MBED_LCD_CFG_SPI settings (1, 2 or 3)
+#endif
+
+/**
+ * Timer for auto-refresh (TIM2 .. TIM5 at APB1) and default frame rate
+ * Refresh is started only when Video RAM is changed, timer stops when there is nothing to send
+ */
+#ifndef REFRESH_TIMER
+#define REFRESH_TIMER 4
+#endif
+#ifndef MBED_LCD_FRAME_RATE
+#define MBED_LCD_FRAME_RATE   200         ///< Frames per second, max. 1000 (timer runs at 10 kHz)
+#endif
+#ifndef MBED_LCD_CMD_QUEUE
+#define MBED_LCD_CMD_QUEUE    4           ///< Slots for asynchronous commands, one is always free
+#endif
+
+/**
+ * Max. SPI clock, from DS - 10MHz (100ns period)
+ */
+#ifndef MBED_LCD_SPI_MAX_CLOCK
+#define MBED_LCD_SPI_MAX_CLOCK  10000000u
+#endif
+
+/**
+ * RTOS hooks - default is bare metal (busy wait, no lock), for FreeRTOS for example
+ * MBED_LCD_OS_LOCK() = xSemaphoreTakeRecursive(lcdMutex, portMAX_DELAY), MBED_LCD_OS_UNLOCK() = xSemaphoreGiveRecursive(lcdMutex)
+ * MBED_LCD_OS_WAIT() = xSemaphoreTake(lcdDone, 1), MBED_LCD_OS_SIGNAL() = give lcdDone from ISR (binary semaphore)
+ */
+#ifndef MBED_LCD_OS_LOCK
+#define MBED_LCD_OS_LOCK()      ((void)0)   ///< MBED_LCD_BeginFrame(), nested calls of same task (recursive mutex)
+#endif
+#ifndef MBED_LCD_OS_UNLOCK
+#define MBED_LCD_OS_UNLOCK()    ((void)0)   ///< MBED_LCD_EndFrame()
+#endif
+#ifndef MBED_LCD_OS_WAIT
+#if defined(MBED_LCD_HOST) && defined(USE_DMA_REFRESH)
+#define MBED_LCD_OS_WAIT()      MBED_LCD_HostWait() ///< Emulated interrupts run while waiting
+#else
+#define MBED_LCD_OS_WAIT()      ((void)0)   ///< Each pass of waiting for refresh, condition is tested again after it
+#endif
+#endif
+#ifndef MBED_LCD_OS_SIGNAL
+#define MBED_LCD_OS_SIGNAL()    ((void)0)   ///< End of refresh, from interrupt with USE_DMA_REFRESH
+#endif
+
+/**
+ * Checks of configuration
+ */
+#if (MBED_LCD_CFG_SCK_PIN > 15) || (MBED_LCD_CFG_MOSI_PIN > 15) || (MBED_LCD_CFG_RSTN_PIN > 15) \
+    || (MBED_LCD_CFG_CSN_PIN > 15) || (MBED_LCD_CFG_A0_PIN > 15)
+#error Invalid pin number in MBED_LCD_CFG_xxx_PIN (0 .. 15)
+#endif
+
+#ifdef _MBED_LCD_STM32F4
+#if (MBED_LCD_CFG_SPI == 1) && ((MBED_LCD_CFG_DMA_TX_STREAM != 3 && MBED_LCD_CFG_DMA_TX_STREAM != 5) \
+    || (MBED_LCD_CFG_DMA_RX_STREAM != 0 && MBED_LCD_CFG_DMA_RX_STREAM != 2))
+#error SPI1 has DMA2 TX stream 3 or 5 and RX stream 0 or 2 (MBED_LCD_CFG_DMA_TX_STREAM, MBED_LCD_CFG_DMA_RX_STREAM)
+#endif
+#if (MBED_LCD_CFG_SPI == 2) && (MBED_LCD_CFG_DMA_TX_STREAM != 4 || MBED_LCD_CFG_DMA_RX_STREAM != 3)
+#error SPI2 has DMA1 TX stream 4 and RX stream 3 (MBED_LCD_CFG_DMA_TX_STREAM, MBED_LCD_CFG_DMA_RX_STREAM)
+#endif
+#if (MBED_LCD_CFG_SPI == 3) && ((MBED_LCD_CFG_DMA_TX_STREAM != 5 && MBED_LCD_CFG_DMA_TX_STREAM != 7) \
+    || (MBED_LCD_CFG_DMA_RX_STREAM != 0 && MBED_LCD_CFG_DMA_RX_STREAM != 2))
+#error SPI3 has DMA1 TX stream 5 or 7 and RX stream 0 or 2 (MBED_LCD_CFG_DMA_TX_STREAM, MBED_LCD_CFG_DMA_RX_STREAM)
+#endif
+#endif
+
+#if defined(_MBED_LCD_STM32F1) && defined(USE_DMA_REFRESH)
+#error DMA auto refresh uses STM32F4 DMA streams, not available for STM32F1
+#endif
+
+#if (REFRESH_TIMER < 2) || (REFRESH_TIMER > 5)
+#error Invalid REFRESH_TIMER settings (2, 3, 4 or 5)
+#endif
+
+#if (MBED_LCD_FRAME_RATE < 1) || (MBED_LCD_FRAME_RATE > 1000)
+#error Invalid MBED_LCD_FRAME_RATE settings (1 .. 1000)
+#endif
+
+#if (MBED_LCD_CMD_QUEUE < 2) || (MBED_LCD_CMD_QUEUE > 255)
+#error Invalid MBED_LCD_CMD_QUEUE settings (2 .. 255)
+#endif
+
+#if (MBED_LCD_INSTANCES < 1) || (MBED_LCD_INSTANCES > 4)
+#error MBED_LCD_INSTANCES must be 1 .. 4
+#endif
+#if (MBED_LCD_INSTANCES > 1) && !defined(MBED_LCD_HW1) && !defined(MBED_LCD_HOST)
+#error MBED_LCD_HW1 (hardware of display 1) must be defined for MBED_LCD_INSTANCES > 1
+#endif
+#if (MBED_LCD_INSTANCES > 2) && !defined(MBED_LCD_HW2) && !defined(MBED_LCD_HOST)
+#error MBED_LCD_HW2 (hardware of display 2) must be defined for MBED_LCD_INSTANCES > 2
+#endif
+#if (MBED_LCD_INSTANCES > 3) && !defined(MBED_LCD_HW3) && !defined(MBED_LCD_HOST)
+#error MBED_LCD_HW3 (hardware of display 3) must be defined for MBED_LCD_INSTANCES > 3
+#endif
+
+/**
+ * Properties of SPIx - APB bus, AF number of pins (not used at STM32F1), DMA controller and channel
+ */
+#define _MBED_LCD_SPI1_APB    2
+#define _MBED_LCD_SPI2_APB    1
+#define _MBED_LCD_SPI3_APB    1
+#ifdef _MBED_LCD_STM32F4
+#define _MBED_LCD_SPI1_AF     5
+#define _MBED_LCD_SPI2_AF     5
+#define _MBED_LCD_SPI3_AF     6
+#else
+#define _MBED_LCD_SPI1_AF     0
+#define _MBED_LCD_SPI2_AF     0
+#define _MBED_LCD_SPI3_AF     0
+#endif
+#define _MBED_LCD_SPI1_DMA    2
+#define _MBED_LCD_SPI1_CH     3
+#define _MBED_LCD_SPI2_DMA    1
+#define _MBED_LCD_SPI2_CH     0
+#define _MBED_LCD_SPI3_DMA    1
+#define _MBED_LCD_SPI3_CH     0
+
+/**
+ * SPI prescaler (CR1 BR bits) for bus clock - smallest divider 2 .. 256 with SPI clock up to MBED_LCD_SPI_MAX_CLOCK
+ */
+#define MBED_LCD_SPI_BR(pclk) ((uint32_t)((pclk) > 2u * MBED_LCD_SPI_MAX_CLOCK) + ((pclk) > 4u * MBED_LCD_SPI_MAX_CLOCK) \
+    + ((pclk) > 8u * MBED_LCD_SPI_MAX_CLOCK) + ((pclk) > 16u * MBED_LCD_SPI_MAX_CLOCK) \
+    + ((pclk) > 32u * MBED_LCD_SPI_MAX_CLOCK) + ((pclk) > 64u * MBED_LCD_SPI_MAX_CLOCK) \
+    + ((pclk) > 128u * MBED_LCD_SPI_MAX_CLOCK))
+
+/**
+ * Hardware of one display (initializer of driver table) - SPI number, pins (port, pin), DMA TX and RX stream
+ * Display 0 is made from MBED_LCD_CFG_xxx, next displays are set globally, for example
+ * MBED_LCD_HW1=MBED_LCD_BOARD(2,GPIOB,13,GPIOB,15,GPIOC,1,GPIOC,2,GPIOC,3,4,3)
+ * Only SPI number and streams are expanded to registers, all at compile time
+ */
+#define MBED_LCD_BOARD(spi, sckPort, sckPin, mosiPort, mosiPin, rstnPort, rstnPin, csnPort, csnPin, a0Port, a0Pin, tx, rx) \
+    _MBED_LCD_BOARD(spi, sckPort, sckPin, mosiPort, mosiPin, rstnPort, rstnPin, csnPort, csnPin, a0Port, a0Pin, tx, rx)
+#define _MBED_LCD_BOARD(spi, sckPort, sckPin, mosiPort, mosiPin, rstnPort, rstnPin, csnPort, csnPin, a0Port, a0Pin, tx, rx) \
+    { _MBED_LCD_BOARD_SPI(spi, _MBED_LCD_SPI##spi##_APB, _MBED_LCD_SPI##spi##_AF), \
+      sckPort, sckPin, mosiPort, mosiPin, rstnPort, rstnPin, csnPort, csnPin, a0Port, a0Pin \
+      _MBED_LCD_BOARD_DMA(tx, rx, _MBED_LCD_SPI##spi##_DMA, _MBED_LCD_SPI##spi##_CH) }
+
+#define _MBED_LCD_BOARD_SPI(spi, apb, af)     _MBED_LCD_BOARD_SPI_(spi, apb, af)
+#define _MBED_LCD_BOARD_SPI_(spi, apb, af)    SPI##spi, &RCC->APB##apb##ENR, &RCC->APB##apb##RSTR, \
+    RCC_APB##apb##ENR_SPI##spi##EN, busClockAPB##apb, af
+
+#ifdef USE_DMA_REFRESH
+#define _MBED_LCD_BOARD_DMA(tx, rx, dma, ch)  _MBED_LCD_BOARD_DMA_(tx, rx, dma, ch)
+#define _MBED_LCD_BOARD_DMA_(tx, rx, dma, ch) , DMA##dma, RCC_AHB1ENR_DMA##dma##EN, tx, rx, ch, DMA##dma##_Stream##rx##_IRQn
+#else
+#define _MBED_LCD_BOARD_DMA(tx, rx, dma, ch)
+#endif
+
+#endif /* MBED_SHIELD_LCD_CONFIG_H_ */
@@ -0,0 +1,162 @@
+/*
+ * mbed_shield_lcd_host.c
+ *
+ * Host transport for build with global symbol MBED_LCD_HOST (Linux, CI, benchmarks)
+ * Bytes from driver go to software model of ST7565 instead of SPI
+ */
+
+#include "mbed_shield_lcd_port.h"
+#include "mbed_shield_lcd_host.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static ST7565_EMU_t m_emu[MBED_LCD_INSTANCES];    ///< Emulated LCD controller for each display
+
+#ifdef USE_DMA_REFRESH
+typedef struct
+{
+  const uint8_t *buf;                     ///< Read at end of transfer, like DMA reads it during transfer
+  uint16_t len;
+  bool a0;
+  bool busy;
+} HostDma_t;
+
+static HostDma_t m_dma[MBED_LCD_INSTANCES];
+static bool m_timerRun;                   ///< CEN of refresh timer
+static bool m_timerPend;                  ///< Tick requested by NVIC pending
+static bool m_inIrq;                      ///< Emulated interrupt runs, pending tick waits for its end
+#endif
+
+bool MBED_LCD_PortInit(uint8_t port)
+{
+  return (port < MBED_LCD_INSTANCES);
+}
+
+bool MBED_LCD_PortReset(uint8_t port)
+{
+  ST7565_EMU_Reset(&m_emu[port]);
+  return true;
+}
+
+void MBED_LCD_PortSend(uint8_t port, uint8_t val, bool a0)
+{
+  ST7565_EMU_Write(&m_emu[port], val, a0);
+}
+
+void MBED_LCD_PortSendData(uint8_t port, const uint8_t *val, uint16_t len)
+{
+  for(; len; len--)
+    ST7565_EMU_Write(&m_emu[port], *val++, true);
+}
+
+void MBED_LCD_PortSendCommands(uint8_t port, const uint8_t *cmds, uint16_t len)
+{
+  for(; len; len--)
+    ST7565_EMU_Write(&m_emu[port], *cmds++, false);
+}
+
+/**
+ * Returns emulated controller of display 0 - display RAM, registers and counters
+ */
+ST7565_EMU_t *MBED_LCD_HostGetEmu(void)
+{
+  return &m_emu[0];
+}
+
+/**
+ * Returns emulated controller of display, NULL for invalid index
+ */
+ST7565_EMU_t *MBED_LCD_HostGetEmuAt(uint8_t port)
+{
+  return (port < MBED_LCD_INSTANCES) ? &m_emu[port] : NULL;
+}
+
+#ifdef USE_DMA_REFRESH
+void MBED_LCD_HostTimerRun(bool run)
+{
+  m_timerRun = run;
+}
+
+static void HOST_TimerIrq(void)
+{
+  m_inIrq = true;
+  m_timerPend = false;
+  MBED_LCD_HostTimerIRQHandler();
+  m_inIrq = false;
+}
+
+/**
+ * Pending from main context enters interrupt immediately, from interrupt it runs at next step
+ */
+void MBED_LCD_HostTimerPend(void)
+{
+  m_timerPend = true;
+  if (!m_inIrq)
+    HOST_TimerIrq();
+}
+
+void MBED_LCD_HostDmaStart(uint8_t port, const uint8_t *buf, uint16_t len, bool a0)
+{
+  m_dma[port].buf = buf;
+  m_dma[port].len = len;
+  m_dma[port].a0 = a0;
+  m_dma[port].busy = true;
+}
+
+/**
+ * One interrupt - end of transfer first (much shorter than timer period), then refresh tick
+ * Returns false when nothing can run - DMA idle, timer stopped and not pending
+ */
+static bool HOST_Step(void)
+{
+  for (uint8_t port = 0; port < MBED_LCD_INSTANCES; port++)
+    if (m_dma[port].busy)
+    {
+      for (uint16_t i = 0; i < m_dma[port].len; i++)
+        ST7565_EMU_Write(&m_emu[port], m_dma[port].buf[i], m_dma[port].a0);
+      m_dma[port].busy = false;
+
+      m_inIrq = true;
+      MBED_LCD_HostDmaIRQHandler(port);
+      m_inIrq = false;
+      return true;
+    }
+
+  if (!m_timerRun && !m_timerPend)
+    return false;
+
+  HOST_TimerIrq();
+  return true;
+}
+
+/**
+ * Run emulated interrupts, at most steps of them - returns true when refresh went idle (timer stopped)
+ */
+bool MBED_LCD_HostRun(uint32_t steps)
+{
+  for (; steps; steps--)
+    if (!HOST_Step())
+      return true;
+
+  return false;
+}
+
+bool MBED_LCD_HostTimerRunning(void)
+{
+  return m_timerRun;
+}
+
+/**
+ * Waiting of driver for end of refresh - without any interrupt to run the condition never changes,
+ * on target it would wait forever, here the program ends with error
+ */
+void MBED_LCD_HostWait(void)
+{
+  if (!HOST_Step())
+  {
+    fprintf(stderr, "MBED_LCD_HostWait: driver waits, but refresh timer is stopped and DMA idle (deadlock)\n");
+    exit(3);
+  }
+}
+#endif
@@ -0,0 +1,20 @@
+/*
+ * mbed_shield_lcd_host.h
+ *
+ * Access to emulated LCD in host build (global symbol MBED_LCD_HOST)
+ */
+
+#ifndef MBED_SHIELD_LCD_HOST_H_
+#define MBED_SHIELD_LCD_HOST_H_
+
+#include "st7565_emu.h"
+
+ST7565_EMU_t *MBED_LCD_HostGetEmu(void);      ///< Emulated controller behind host transport (display 0)
+ST7565_EMU_t *MBED_LCD_HostGetEmuAt(uint8_t port);    ///< Emulated controller of display, see MBED_LCD_Select()
+
+#ifdef USE_DMA_REFRESH
+bool MBED_LCD_HostRun(uint32_t steps);        ///< Run emulated interrupts until timer stops and DMA is idle, false = still busy
+bool MBED_LCD_HostTimerRunning(void);         ///< Refresh timer counts
+#endif
+
+#endif /* MBED_SHIELD_LCD_HOST_H_ */
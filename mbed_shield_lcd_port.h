@@ -0,0 +1,43 @@
+/*
+ * mbed_shield_lcd_port.h
+ *
+ * Transport between driver and LCD controller - RST, A0, CS signals and SPI byte path
+ * Every function gets index of display (port), the driver supports more displays at own buses
+ * Target implementation is part of mbed_shield_lcd.c,
+ * host build (global symbol MBED_LCD_HOST) uses mbed_shield_lcd_host.c with ST7565 emulator
+ */
+
+#ifndef MBED_SHIELD_LCD_PORT_H_
+#define MBED_SHIELD_LCD_PORT_H_
+
+#ifndef bool
+#include <stdbool.h>
+#endif
+
+#ifndef uint8_t
+#include <stdint.h>
+#endif
+
+#ifndef MBED_LCD_INSTANCES
+#define MBED_LCD_INSTANCES  1           ///< Count of displays, each has own transport (port 0 .. MBED_LCD_INSTANCES - 1)
+#endif
+
+bool MBED_LCD_PortInit(uint8_t port);                                 ///< Init signals and SPI, false when fails
+bool MBED_LCD_PortReset(uint8_t port);                                ///< Reset pulse for LCD controller
+void MBED_LCD_PortSend(uint8_t port, uint8_t val, bool a0);           ///< Single byte, A0 selects CMD = 0, DATA = 1
+void MBED_LCD_PortSendData(uint8_t port, const uint8_t *val, uint16_t len);   ///< Block of data bytes (A0 = 1)
+void MBED_LCD_PortSendCommands(uint8_t port, const uint8_t *cmds, uint16_t len);  ///< Block of commands (A0 = 0), one CS
+
+#if defined(MBED_LCD_HOST) && defined(USE_DMA_REFRESH)
+/**
+ * Host emulation of refresh timer and DMA (mbed_shield_lcd_host.c), interrupt handlers are in the driver
+ */
+void MBED_LCD_HostTimerRun(bool run);                                 ///< Timer counts (CEN), ticks at steps of MBED_LCD_HostRun()
+void MBED_LCD_HostTimerPend(void);                                    ///< Tick now (NVIC pending), after current interrupt
+void MBED_LCD_HostDmaStart(uint8_t port, const uint8_t *buf, uint16_t len, bool a0);  ///< Bytes reach LCD at end of transfer
+void MBED_LCD_HostWait(void);                                         ///< MBED_LCD_OS_WAIT() - interrupts run while waiting
+void MBED_LCD_HostTimerIRQHandler(void);                              ///< Driver - refresh tick of all displays
+void MBED_LCD_HostDmaIRQHandler(uint8_t port);                        ///< Driver - end of transfer
+#endif
+
+#endif /* MBED_SHIELD_LCD_PORT_H_ */
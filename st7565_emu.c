@@ -0,0 +1,178 @@
+/*
+ * st7565_emu.c
+ *
+ * Software model of ST7565R controller, only for host build
+ * Command set see ST7565R datasheet, table 16 (Table of LCD display commands)
+ */
+
+#include "st7565_emu.h"
+#include <stdio.h>
+
+/**
+ * State after RST signal - see DS "Initialization by the reset pin"
+ * Display RAM is not changed by reset
+ */
+void ST7565_EMU_Reset(ST7565_EMU_t *emu)
+{
+  emu->page = 0;
+  emu->column = 0;
+  emu->startLine = 0;
+  emu->contrast = 0x20;
+  emu->powerControl = 0;
+  emu->resistorRatio = 0;
+  emu->bias = 0;
+
+  emu->displayOn = false;
+  emu->reverse = false;
+  emu->allPointsOn = false;
+  emu->adcReverse = false;
+  emu->comReverse = false;
+
+  emu->argCmd = 0;
+  emu->rmw = false;
+  emu->rmwColumn = 0;
+}
+
+/**
+ * Decode single command byte, commands with argument waits for next byte
+ */
+static void ST7565_EMU_Command(ST7565_EMU_t *emu, uint8_t cmd)
+{
+  emu->cmdCount++;
+
+  if (emu->argCmd != 0)                 // 2nd byte of double byte command
+  {
+    if (emu->argCmd == 0x81)
+      emu->contrast = cmd & 0x3F;       // (18) Electronic volume register set
+    // 0xAC static indicator, 0xF8 booster ratio - no effect to display RAM
+    emu->argCmd = 0;
+    return;
+  }
+
+  if ((cmd & 0xC0) == 0x40)             // (2) Display start line set
+    emu->startLine = cmd & 0x3F;
+  else if ((cmd & 0xF0) == 0xB0)        // (3) Page address set
+    emu->page = cmd & 0x0F;
+  else if ((cmd & 0xF0) == 0x10)        // (4) Column address set, upper bits
+    emu->column = (emu->column & 0x0F) | ((cmd & 0x0F) << 4);
+  else if ((cmd & 0xF0) == 0x00)        // (4) Column address set, lower bits
+    emu->column = (emu->column & 0xF0) | (cmd & 0x0F);
+  else if ((cmd & 0xF8) == 0x28)        // (16) Power controller set
+    emu->powerControl = cmd & 0x07;
+  else if ((cmd & 0xF8) == 0x20)        // (17) V0 voltage regulator internal resistor ratio set
+    emu->resistorRatio = cmd & 0x07;
+  else if ((cmd & 0xF0) == 0xC0)        // (15) Common output mode select
+    emu->comReverse = (cmd & 0x08) != 0;
+  else
+  {
+    switch(cmd)
+    {
+      case 0xAE:                        // (1) Display OFF
+      case 0xAF:                        // (1) Display ON
+        emu->displayOn = cmd & 0x01;
+        break;
+      case 0xA0:                        // (8) ADC select
+      case 0xA1:
+        emu->adcReverse = cmd & 0x01;
+        break;
+      case 0xA6:                        // (9) Display normal/reverse
+      case 0xA7:
+        emu->reverse = cmd & 0x01;
+        break;
+      case 0xA4:                        // (10) Display all points ON/OFF
+      case 0xA5:
+        emu->allPointsOn = cmd & 0x01;
+        break;
+      case 0xA2:                        // (11) LCD bias set
+      case 0xA3:
+        emu->bias = cmd & 0x01;
+        break;
+      case 0xE0:                        // (12) Read-modify-write
+        emu->rmw = true;
+        emu->rmwColumn = emu->column;
+        break;
+      case 0xEE:                        // (13) End
+        if (emu->rmw)
+          emu->column = emu->rmwColumn;
+        emu->rmw = false;
+        break;
+      case 0xE2:                        // (14) Internal reset
+        ST7565_EMU_Reset(emu);
+        break;
+      case 0x81:                        // (18) Electronic volume mode set
+      case 0xAC:                        // (19) Static indicator ON
+      case 0xAD:
+      case 0xF8:                        // (20) Booster ratio set
+        emu->argCmd = cmd;
+        break;
+      case 0xE3:                        // (22) NOP
+        break;
+      default:
+        emu->unknownCount++;
+        break;
+    }
+  }
+}
+
+/**
+ * Byte from transport, A0 = 0 command, 1 data
+ * Data goes to display RAM at page and column, column is incremented up to last one
+ */
+void ST7565_EMU_Write(ST7565_EMU_t *emu, uint8_t val, bool a0)
+{
+  if (!a0)
+  {
+    ST7565_EMU_Command(emu, val);
+    return;
+  }
+
+  emu->dataCount++;
+
+  if ((emu->page < ST7565_EMU_PAGES) && (emu->column < ST7565_EMU_COLUMNS))
+    emu->ram[emu->page][emu->column] = val;
+
+  if (emu->column < ST7565_EMU_COLUMNS)
+    emu->column++;
+}
+
+/**
+ * Visible pixel at panel position - display line y shows RAM row (start line + y) mod 64
+ * ADC reverse mirrors columns, reverse and all points ON are applied like in controller
+ */
+bool ST7565_EMU_GetPixel(const ST7565_EMU_t *emu, uint8_t x, uint8_t y)
+{
+  uint8_t row = (emu->startLine + y) % ST7565_EMU_LINES;
+  uint8_t col = emu->adcReverse ? (ST7565_EMU_COLUMNS - 1 - x) : x;
+  bool pix;
+
+  if (!emu->displayOn || (x >= ST7565_EMU_COLUMNS))
+    return false;
+
+  if (emu->allPointsOn)
+    return true;
+
+  pix = (emu->ram[row / 8][col] >> (row % 8)) & 0x01;
+  return emu->reverse ? !pix : pix;
+}
+
+/**
+ * Save visible content (cols x rows pixels) as plain PBM, black = 1
+ * Returns false when file cannot be written
+ */
+bool ST7565_EMU_SavePBM(const ST7565_EMU_t *emu, const char *fileName, uint8_t cols, uint8_t rows)
+{
+  FILE *f = fopen(fileName, "w");
+
+  if (f == NULL)
+    return false;
+
+  fprintf(f, "P1\n%d %d\n", cols, rows);
+  for (uint8_t y = 0; y < rows; y++)
+  {
+    for (uint8_t x = 0; x < cols; x++)
+      fputc(ST7565_EMU_GetPixel(emu, x, y) ? '1' : '0', f);
+    fputc('\n', f);
+  }
+
+  return fclose(f) == 0;
+}
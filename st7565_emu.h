@@ -0,0 +1,55 @@
+/*
+ * st7565_emu.h
+ *
+ * Software model of ST7565R controller for host build - decodes commands from transport
+ * into own display RAM, so content of LCD can be checked without real HW
+ */
+
+#ifndef ST7565_EMU_H_
+#define ST7565_EMU_H_
+
+#ifndef bool
+#include <stdbool.h>
+#endif
+
+#ifndef uint8_t
+#include <stdint.h>
+#endif
+
+#define ST7565_EMU_PAGES    9             ///< Display RAM 65 rows = 8 pages + icon page
+#define ST7565_EMU_COLUMNS  132           ///< Display RAM columns
+#define ST7565_EMU_LINES    64            ///< Rows used for start line ring (pages 0..7)
+
+typedef struct
+{
+  uint8_t ram[ST7565_EMU_PAGES][ST7565_EMU_COLUMNS];  ///< Display RAM, bytes = columns, LSB on top
+
+  uint8_t page;                   ///< Page address (0xB0)
+  uint8_t column;                 ///< Column address (0x1x, 0x0x), incremented by data write
+  uint8_t startLine;              ///< Display start line (0x40)
+  uint8_t contrast;               ///< Electronic volume (0x81 + value)
+  uint8_t powerControl;           ///< Power control bits (0x28)
+  uint8_t resistorRatio;          ///< V0 voltage regulator ratio (0x20)
+  uint8_t bias;                   ///< LCD bias, 0 = 1/9, 1 = 1/7 (0xA2, 0xA3)
+
+  bool displayOn;                 ///< 0xAE / 0xAF
+  bool reverse;                   ///< Inverted pixels, 0xA6 / 0xA7
+  bool allPointsOn;               ///< 0xA4 / 0xA5
+  bool adcReverse;                ///< Segment direction, 0xA0 / 0xA1
+  bool comReverse;                ///< Common direction, 0xC0 / 0xC8
+
+  uint8_t argCmd;                 ///< Command waiting for 2nd byte (0x81, 0xAC, 0xF8), 0 = none
+  bool rmw;                       ///< Read-modify-write mode (0xE0 .. 0xEE)
+  uint8_t rmwColumn;              ///< Column restored at end of read-modify-write
+
+  uint32_t cmdCount;              ///< Count of received command bytes
+  uint32_t dataCount;             ///< Count of received data bytes
+  uint32_t unknownCount;          ///< Count of not decoded commands
+} ST7565_EMU_t;
+
+void ST7565_EMU_Reset(ST7565_EMU_t *emu);                       ///< State after RST signal, display RAM keeps content
+void ST7565_EMU_Write(ST7565_EMU_t *emu, uint8_t val, bool a0); ///< Byte from transport, A0 = 0 command, 1 data
+bool ST7565_EMU_GetPixel(const ST7565_EMU_t *emu, uint8_t x, uint8_t y);  ///< Visible pixel at panel position
+bool ST7565_EMU_SavePBM(const ST7565_EMU_t *emu, const char *fileName, uint8_t cols, uint8_t rows);  ///< Visible content to PBM file
+
+#endif /* ST7565_EMU_H_ */
@@ -0,0 +1,536 @@
+/*
+ * host_test.c
+ *
+ * Regression tests for host build (MBED_LCD_HOST), see Makefile - same source is built for default,
+ * band mode, overlay, double buffer and DMA refresh variant. Each case draws to Video RAM and to pixel model here,
+ * refreshes ST7565 emulator and compares visible pixels. Then whole display is refreshed again and
+ * result must be the same (changed spans, hardware scroll and overlay marks cover all changes)
+ * Exit code is count of failed checks
+ */
+
+#include "mbed_shield_lcd.h"
+#include "mbed_shield_lcd_host.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TEST_COLUMNS    128
+#define TEST_ROWS       32
+#define TEST_INVERT     2                 ///< Operation of TEST_ModelRect()
+#define TEST_STEPS      1000              ///< Emulated interrupts of one refresh with USE_DMA_REFRESH
+
+static uint8_t m_model[TEST_ROWS][TEST_COLUMNS];  ///< Expected pixel at LCD, 1 = black
+static uint32_t m_seed = 12345;
+static int m_failed;
+static int m_checks;
+
+/**
+ * Deterministic pseudo-random bytes (LCG), same data in each build
+ */
+static uint8_t TEST_Rand(void)
+{
+  m_seed = m_seed * 1103515245u + 12345u;
+  return m_seed >> 16;
+}
+
+static void TEST_Check(bool ok, const char *name)
+{
+  m_checks++;
+  if (!ok)
+  {
+    printf("FAIL %s\n", name);
+    m_failed++;
+  }
+}
+
+static void TEST_ModelClear(void)
+{
+  memset(m_model, 0, sizeof(m_model));
+}
+
+/**
+ * Model of solid rectangle - op is 0 (white), 1 (black) or TEST_INVERT, limited by clip cx0, cy0 .. cx1 - 1, cy1 - 1
+ */
+static void TEST_ModelRect(uint8_t model[TEST_ROWS][TEST_COLUMNS], int x, int y, int w, int h, int op,
+    int cx0, int cy0, int cx1, int cy1)
+{
+  for (int r = y; r < y + h; r++)
+    for (int c = x; c < x + w; c++)
+      if ((r >= cy0) && (r < cy1) && (c >= cx0) && (c < cx1))
+      {
+        if (op == TEST_INVERT)
+          model[r][c] ^= 1;
+        else
+          model[r][c] = op;
+      }
+}
+
+/**
+ * Pixel of bitmap in any format
+ */
+static bool TEST_BmpPixel(const MBED_LCD_Bitmap_t *bmp, const uint8_t *data, int c, int r)
+{
+  if (bmp->format == MBED_LCD_BMP_PAGES)
+    return (data[(r / 8) * bmp->width + c] >> (r % 8)) & 1;
+
+  return (data[r * ((bmp->width + 7) / 8) + c / 8] >> (7 - c % 8)) & 1;
+}
+
+/**
+ * Raster operation of bitmap to pixel model (or any model with same layout)
+ */
+static void TEST_ModelBitmap(uint8_t model[TEST_ROWS][TEST_COLUMNS], int x, int y, const MBED_LCD_Bitmap_t *bmp, MBED_LCD_Rop_t rop)
+{
+  for (int r = 0; r < bmp->height; r++)
+    for (int c = 0; c < bmp->width; c++)
+    {
+      int X = x + c, Y = y + r;
+      uint8_t s, d;
+
+      if ((X < 0) || (X >= TEST_COLUMNS) || (Y < 0) || (Y >= TEST_ROWS))
+        continue;
+      if ((bmp->mask != NULL) && !TEST_BmpPixel(bmp, bmp->mask, c, r))
+        continue;
+
+      s = (bmp->data != NULL) ? TEST_BmpPixel(bmp, bmp->data, c, r) : 1;
+      d = model[Y][X];
+      switch (rop)
+      {
+        case MBED_LCD_ROP_COPY:   d = s;        break;
+        case MBED_LCD_ROP_OR:     d |= s;       break;
+        case MBED_LCD_ROP_AND:    d &= s;       break;
+        case MBED_LCD_ROP_XOR:    d ^= s;       break;
+        case MBED_LCD_ROP_ANDNOT: d &= !s;      break;
+      }
+      model[Y][X] = d;
+    }
+}
+
+/**
+ * Send changes to emulator (back buffer is published first)
+ */
+static void TEST_Refresh(void)
+{
+#ifdef MBED_LCD_DOUBLE_BUFFER
+  MBED_LCD_SwapBuffers();
+#endif
+  MBED_LCD_VideoRam2LCD();
+#ifdef USE_DMA_REFRESH
+  TEST_Check(MBED_LCD_HostRun(TEST_STEPS), "refresh ends");  // transfer runs in emulated interrupts
+#endif
+}
+
+/**
+ * Compare visible pixels of emulator with model, reports first difference
+ */
+static bool TEST_CompareLCD(const uint8_t model[TEST_ROWS][TEST_COLUMNS], const char *name)
+{
+  ST7565_EMU_t *emu = MBED_LCD_HostGetEmu();
+
+  for (int y = 0; y < TEST_ROWS; y++)
+    for (int x = 0; x < TEST_COLUMNS; x++)
+      if (ST7565_EMU_GetPixel(emu, x, y) != model[y][x])
+      {
+        printf("%s: pixel %d,%d is %d, expected %d\n", name, x, y, !model[y][x], model[y][x]);
+        return false;
+      }
+
+  return true;
+}
+
+/**
+ * Refresh changes and compare LCD with model (Video RAM with overlay), then refresh all and compare again
+ * Without band mode also content of Video RAM is compared with m_model
+ */
+static void TEST_Verify(const uint8_t model[TEST_ROWS][TEST_COLUMNS], const char *name)
+{
+  char full[64];
+
+#ifndef MBED_LCD_BAND_MODE
+  static uint8_t saved[MBED_LCD_RECT_SIZE(TEST_COLUMNS, TEST_ROWS)];
+  bool same = true;
+
+  MBED_LCD_SaveRect(0, 0, TEST_COLUMNS, TEST_ROWS, saved);
+  for (int y = 0; y < TEST_ROWS; y++)
+    for (int x = 0; x < TEST_COLUMNS; x++)
+      if (((saved[(y / 8) * TEST_COLUMNS + x] >> (y % 8)) & 1) != m_model[y][x])
+        same = false;
+  snprintf(full, sizeof(full), "%s (Video RAM)", name);
+  TEST_Check(same, full);
+#endif
+
+  TEST_Refresh();
+  TEST_Check(TEST_CompareLCD(model, name), name);
+
+  MBED_LCD_Invalidate();
+  TEST_Refresh();
+  snprintf(full, sizeof(full), "%s (full refresh)", name);
+  TEST_Check(TEST_CompareLCD(model, full), full);
+}
+
+/**
+ * Clip rectangle, nested clip and primitives clipped by it
+ */
+static void TEST_Clip(void)
+{
+  MBED_LCD_InitVideoRam(0x00);
+  TEST_ModelClear();
+
+  MBED_LCD_SetClip(10, 4, 40, 20);                      // 10 .. 49, 4 .. 23
+  MBED_LCD_FillRect(0, 0, TEST_COLUMNS, TEST_ROWS, true);
+  TEST_ModelRect(m_model, 0, 0, TEST_COLUMNS, TEST_ROWS, 1, 10, 4, 50, 24);
+
+  MBED_LCD_PushClip(30, 0, 60, 10);                     // intersection 30 .. 49, 4 .. 9
+  MBED_LCD_FillRect(0, 0, TEST_COLUMNS, TEST_ROWS, false);
+  TEST_ModelRect(m_model, 0, 0, TEST_COLUMNS, TEST_ROWS, 0, 30, 4, 50, 10);
+  MBED_LCD_PopClip();
+
+  MBED_LCD_InvertRect(0, 13, TEST_COLUMNS, 5);
+  TEST_ModelRect(m_model, 0, 13, TEST_COLUMNS, 5, TEST_INVERT, 10, 4, 50, 24);
+
+  MBED_LCD_SetClip(-20, 30, 200, 50);                   // limited by display
+  MBED_LCD_FillRect(0, 0, TEST_COLUMNS, TEST_ROWS, true);
+  TEST_ModelRect(m_model, 0, 0, TEST_COLUMNS, TEST_ROWS, 1, 0, 30, TEST_COLUMNS, TEST_ROWS);
+  MBED_LCD_ResetClip();
+
+  MBED_LCD_FillRect(120, -3, 20, 6, true);              // clipped by display only
+  TEST_ModelRect(m_model, 120, -3, 20, 6, 1, 0, 0, TEST_COLUMNS, TEST_ROWS);
+
+  TEST_Verify(m_model, "clip");
+}
+
+/**
+ * Each raster operation for both bitmap formats, with mask, at unaligned and clipped positions
+ */
+static void TEST_Bitmap(void)
+{
+  static uint8_t rows[13 * 3], pages[2 * 21], mask[2 * 21];
+  static const MBED_LCD_Bitmap_t bmpRows = { 20, 13, MBED_LCD_BMP_ROWS, rows, NULL };
+  static const MBED_LCD_Bitmap_t bmpPages = { 21, 11, MBED_LCD_BMP_PAGES, pages, NULL };
+  static const MBED_LCD_Bitmap_t bmpMask = { 21, 11, MBED_LCD_BMP_PAGES, pages, mask };
+  static const char *names[] = { "bitmap copy", "bitmap or", "bitmap and", "bitmap xor", "bitmap andnot" };
+
+  for (unsigned i = 0; i < sizeof(rows); i++)
+    rows[i] = TEST_Rand();
+  for (unsigned i = 0; i < sizeof(pages); i++)
+  {
+    pages[i] = TEST_Rand();
+    mask[i] = TEST_Rand();
+  }
+
+  for (int rop = MBED_LCD_ROP_COPY; rop <= MBED_LCD_ROP_ANDNOT; rop++)
+  {
+    MBED_LCD_InitVideoRam(0x00);
+    TEST_ModelClear();
+    MBED_LCD_FillRect(0, 0, 64, TEST_ROWS, true);       // background half black
+    TEST_ModelRect(m_model, 0, 0, 64, TEST_ROWS, 1, 0, 0, TEST_COLUMNS, TEST_ROWS);
+
+    MBED_LCD_DrawBitmap(54, 3, &bmpRows, rop);
+    TEST_ModelBitmap(m_model, 54, 3, &bmpRows, rop);
+    MBED_LCD_DrawBitmap(110, -5, &bmpPages, rop);
+    TEST_ModelBitmap(m_model, 110, -5, &bmpPages, rop);
+    MBED_LCD_DrawBitmap(-4, 26, &bmpMask, rop);
+    TEST_ModelBitmap(m_model, -4, 26, &bmpMask, rop);
+    MBED_LCD_DrawBitmap(20, 8, &bmpMask, rop);          // aligned to page
+    TEST_ModelBitmap(m_model, 20, 8, &bmpMask, rop);
+
+    TEST_Verify(m_model, names[rop]);
+  }
+}
+
+/**
+ * Font 16 rows (two bands) drawn above top of display - page of glyph top is negative, cell spacing is cleared
+ */
+static uint8_t m_tallData[2 * 2 * 5];
+static const MBED_LCD_Font_t m_tallFont = { 16, 5, 1, 0, 'A', 2, NULL, NULL, NULL, m_tallData };
+
+static void TEST_TallFont(void)
+{
+  static const int ys[] = { -12, -20, -16, -3, 27 };
+
+  for (unsigned i = 0; i < sizeof(m_tallData); i++)
+    m_tallData[i] = TEST_Rand();
+
+  MBED_LCD_InitVideoRam(0x00);
+  TEST_ModelClear();
+  MBED_LCD_FillRect(0, 0, TEST_COLUMNS, TEST_ROWS, true);  // spacing column is cleared on black
+  TEST_ModelRect(m_model, 0, 0, TEST_COLUMNS, TEST_ROWS, 1, 0, 0, TEST_COLUMNS, TEST_ROWS);
+
+  MBED_LCD_SetFont(&m_tallFont);
+  for (unsigned i = 0; i < sizeof(ys) / sizeof(ys[0]); i++)
+  {
+    int x = 10 + i * 20;
+
+    TEST_Check(MBED_LCD_DrawText(x, ys[i], "AB") == x + 12, "tall font advance");
+    for (int g = 0; g < 2; g++)
+    {
+      MBED_LCD_Bitmap_t glyph = { 5, 16, MBED_LCD_BMP_PAGES, &m_tallData[g * 10], NULL };
+
+      TEST_ModelBitmap(m_model, x + g * 6, ys[i], &glyph, MBED_LCD_ROP_COPY);
+      TEST_ModelRect(m_model, x + g * 6 + 5, ys[i], 1, 16, 0, 0, 0, TEST_COLUMNS, TEST_ROWS);
+    }
+  }
+  MBED_LCD_SetFont(NULL);
+
+  TEST_Verify(m_model, "tall font above top");
+}
+
+/**
+ * Compressed image 8 x 2 pages - runs cross band border, drawn whole and clipped by display
+ */
+static const uint8_t m_rle[] = { 8, 2, 0x83, 0xFF, 0x04, 0x01, 0x02, 0x03, 0x04, 0x05, 0x84, 0xAA };
+static const uint8_t m_rleRaw[16] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01, 0x02, 0x03, 0x04, 0x05, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA };
+static const MBED_LCD_Bitmap_t m_rleBmp = { 8, 16, MBED_LCD_BMP_PAGES, m_rleRaw, NULL };
+
+static void TEST_ImageRLE(void)
+{
+  MBED_LCD_InitVideoRam(0x00);
+  TEST_ModelClear();
+  MBED_LCD_FillRect(0, 0, TEST_COLUMNS, 8, true);       // copy overwrites background
+
+  TEST_Check(MBED_LCD_DrawImageRLE(3, 0, m_rle, sizeof(m_rle)), "rle decode");
+  TEST_Check(MBED_LCD_DrawImageRLE(124, 3, m_rle, sizeof(m_rle)), "rle clipped decode");
+  TEST_Check(MBED_LCD_DrawImageRLE(-5, 1, m_rle, sizeof(m_rle)), "rle left clipped decode");
+
+  TEST_ModelRect(m_model, 0, 0, TEST_COLUMNS, 8, 1, 0, 0, TEST_COLUMNS, TEST_ROWS);
+  TEST_ModelBitmap(m_model, 3, 0, &m_rleBmp, MBED_LCD_ROP_COPY);
+  TEST_ModelBitmap(m_model, 124, 24, &m_rleBmp, MBED_LCD_ROP_COPY);
+  TEST_ModelBitmap(m_model, -5, 8, &m_rleBmp, MBED_LCD_ROP_COPY);
+
+  TEST_Verify(m_model, "rle");
+}
+
+/**
+ * Full display image streamed to LCD - 4 literal bytes, then repeated 0x55
+ */
+static const uint8_t m_rleFull[] = { 128, 4, 0x03, 0x01, 0x02, 0x03, 0x04, 0xFF, 0x55, 0xFF, 0x55, 0xFF, 0x55, 0xF7, 0x55 };
+
+#ifndef USE_DMA_REFRESH                                 // refresh owns SPI, no direct stream
+static void TEST_StreamRLE(void)
+{
+  static uint8_t view[TEST_ROWS][TEST_COLUMNS];
+
+  for (int y = 0; y < TEST_ROWS; y++)
+    for (int x = 0; x < TEST_COLUMNS; x++)
+      view[y][x] = (((x < 4) && (y < 8)) ? (x + 1) : 0x55) >> (y % 8) & 1;
+
+  TEST_Check(MBED_LCD_StreamImageRLE(m_rleFull, sizeof(m_rleFull)), "rle stream");
+  TEST_Check(TEST_CompareLCD(view, "rle stream"), "rle stream");
+
+  MBED_LCD_Invalidate();                                // Video RAM was not changed
+  TEST_Refresh();
+  TEST_Check(TEST_CompareLCD(m_model, "rle stream overwritten"), "rle stream overwritten");
+}
+#endif
+
+/**
+ * Image cut at any byte is refused. Each copy has exact size, so read behind it is found by
+ * address sanitizer (make run CFLAGS="-g -fsanitize=address"). Band mode checks only header
+ * of recorded image, damage is found when it is replayed
+ */
+static void TEST_TruncatedRLE(void)
+{
+  bool ok = true;
+
+  for (uint16_t size = 0; size < sizeof(m_rleFull); size++)
+  {
+    uint8_t *img = malloc((size > 0) ? size : 1);       // malloc(0) can be NULL
+
+    memcpy(img, m_rleFull, size);
+#ifndef USE_DMA_REFRESH
+    if (MBED_LCD_StreamImageRLE(img, size))
+      ok = false;
+#endif
+#ifndef MBED_LCD_BAND_MODE
+    if ((size < sizeof(m_rle)) && MBED_LCD_DrawImageRLE(0, 0, memcpy(img, m_rle, size), size))
+      ok = false;
+#endif
+    free(img);
+  }
+  TEST_Check(ok, "rle truncated");
+
+  MBED_LCD_InitVideoRam(0x00);                          // partially decoded images
+  MBED_LCD_Invalidate();                                // streamed parts are not in Video RAM
+  TEST_ModelClear();
+  TEST_Verify(m_model, "rle truncated");
+}
+
+#ifndef MBED_LCD_BAND_MODE
+/**
+ * Hardware scroll - content moves by start line of controller, head goes around ring of 8 pages
+ * of controller RAM. Every line gets own mark, so lost or misplaced page is visible
+ */
+static void TEST_Scroll(void)
+{
+  ST7565_EMU_t *emu = MBED_LCD_HostGetEmu();
+  uint8_t starts = 0;                                   // bit for each start line seen
+
+  MBED_LCD_InitVideoRam(0x00);
+  TEST_ModelClear();
+  for (int p = 0; p < 4; p++)
+  {
+    MBED_LCD_FillRect(p * 10, p * 8 + 1, 8, 6, true);
+    TEST_ModelRect(m_model, p * 10, p * 8 + 1, 8, 6, 1, 0, 0, TEST_COLUMNS, TEST_ROWS);
+  }
+  TEST_Verify(m_model, "scroll setup");
+
+  for (int n = 0; n < 11; n++)
+  {
+    uint8_t lines = (n == 9) ? 2 : 1;
+
+    MBED_LCD_ScrollUpLines(lines);
+    memmove(m_model[0], m_model[lines * 8], (TEST_ROWS - lines * 8) * TEST_COLUMNS);
+    memset(m_model[TEST_ROWS - lines * 8], 0, lines * 8 * TEST_COLUMNS);
+
+    MBED_LCD_FillRect(40 + n * 7, 27, 5, 3, true);      // new bottom line
+    TEST_ModelRect(m_model, 40 + n * 7, 27, 5, 3, 1, 0, 0, TEST_COLUMNS, TEST_ROWS);
+
+    TEST_Refresh();
+    TEST_Check(TEST_CompareLCD(m_model, "scroll"), "scroll");
+    starts |= 1 << (emu->startLine / 8);
+  }
+  TEST_Check(starts == 0xFF, "scroll uses all pages of ring");
+  TEST_Verify(m_model, "scroll");
+
+  MBED_LCD_ScrollUpLines(9);                            // more than display, all cleared
+  TEST_ModelClear();
+  TEST_Verify(m_model, "scroll all");
+}
+#endif
+
+#ifdef MBED_LCD_OVERLAY
+/**
+ * Overlay items are merged while sending, Video RAM is not changed. Moved or hidden item restores
+ * background, result equals full refresh
+ */
+static void TEST_Overlay(void)
+{
+  static uint8_t icon[2 * 12];
+  static const MBED_LCD_Bitmap_t bmp = { 12, 10, MBED_LCD_BMP_PAGES, icon, NULL };
+  static uint8_t view[TEST_ROWS][TEST_COLUMNS];
+
+  for (unsigned i = 0; i < sizeof(icon); i++)
+    icon[i] = TEST_Rand();
+
+  MBED_LCD_InitVideoRam(0x00);
+  TEST_ModelClear();
+  MBED_LCD_FillRect(0, 0, 64, TEST_ROWS, true);
+  TEST_ModelRect(m_model, 0, 0, 64, TEST_ROWS, 1, 0, 0, TEST_COLUMNS, TEST_ROWS);
+  TEST_Verify(m_model, "overlay setup");
+
+  TEST_Check(MBED_LCD_OverlayRect(0, 50, 5, 30, 10, MBED_LCD_ROP_XOR), "overlay rect");
+  TEST_Check(MBED_LCD_OverlayBitmap(1, 100, 13, &bmp, MBED_LCD_ROP_OR), "overlay bitmap");
+  memcpy(view, m_model, sizeof(view));                  // model stays Video RAM, view is LCD
+  TEST_ModelRect(view, 50, 5, 30, 10, TEST_INVERT, 0, 0, TEST_COLUMNS, TEST_ROWS);
+  TEST_ModelBitmap(view, 100, 13, &bmp, MBED_LCD_ROP_OR);
+  TEST_Verify(view, "overlay");
+
+  TEST_Check(MBED_LCD_OverlayMove(0, 60, -3), "overlay move");
+  MBED_LCD_FillRect(70, 20, 20, 4, true);               // background changes under other item
+  TEST_ModelRect(m_model, 70, 20, 20, 4, 1, 0, 0, TEST_COLUMNS, TEST_ROWS);
+  memcpy(view, m_model, sizeof(view));
+  TEST_ModelRect(view, 60, -3, 30, 10, TEST_INVERT, 0, 0, TEST_COLUMNS, TEST_ROWS);
+  TEST_ModelBitmap(view, 100, 13, &bmp, MBED_LCD_ROP_OR);
+  TEST_Verify(view, "overlay moved");
+
+  TEST_Check(MBED_LCD_OverlayShow(0, false), "overlay hide");
+  TEST_Check(MBED_LCD_OverlayShow(1, false), "overlay hide");
+  TEST_Verify(m_model, "overlay hidden");
+}
+#endif
+
+#ifdef USE_DMA_REFRESH
+/**
+ * Frame ended while async command is on SPI - command goes first and refresh of the frame must follow
+ * without any other change, although refresh timer stopped while the frame was drawn
+ */
+static int m_commandsDone;
+
+static void TEST_CommandDone(void)
+{
+  m_commandsDone++;
+}
+
+static void TEST_AsyncCommandFrame(void)
+{
+  ST7565_EMU_t *emu = MBED_LCD_HostGetEmu();
+
+  MBED_LCD_BeginFrame();
+  MBED_LCD_InitVideoRam(0x00);
+  TEST_ModelClear();
+  MBED_LCD_FillRect(20, 5, 30, 10, true);
+  TEST_ModelRect(m_model, 20, 5, 30, 10, 1, 0, 0, TEST_COLUMNS, TEST_ROWS);
+  TEST_Check(MBED_LCD_HostRun(TEST_STEPS) && !MBED_LCD_HostTimerRunning(), "timer stops while frame is drawn");
+
+  TEST_Check(MBED_LCD_SetContrastAsync(33, TEST_CommandDone), "async command queued");
+  MBED_LCD_EndFrame(false);                             // its tick finds SPI busy with the command
+
+  TEST_Check(MBED_LCD_HostRun(TEST_STEPS), "refresh ends");
+  TEST_Check((m_commandsDone == 1) && (emu->contrast == 33), "async command sent");
+  TEST_Check(TEST_CompareLCD(m_model, "frame after async command"), "frame after async command");
+}
+#endif
+
+static int m_framesDone;
+
+static void TEST_FrameDone(void)
+{
+  m_framesDone++;
+}
+
+/**
+ * Frame published behind async command is acknowledged - with DMA a lost acknowledgement
+ * ends MBED_LCD_EndFrame(true) by deadlock error of MBED_LCD_HostWait()
+ */
+static void TEST_FrameAcknowledged(void)
+{
+  MBED_LCD_SetFrameCallback(TEST_FrameDone);
+
+  MBED_LCD_BeginFrame();
+  MBED_LCD_InitVideoRam(0x00);
+  TEST_ModelClear();
+  MBED_LCD_FillRect(40, 8, 12, 20, true);
+  TEST_ModelRect(m_model, 40, 8, 12, 20, 1, 0, 0, TEST_COLUMNS, TEST_ROWS);
+#ifdef USE_DMA_REFRESH
+  TEST_Check(MBED_LCD_HostRun(TEST_STEPS), "refresh ends before frame");
+#endif
+  m_framesDone = 0;
+
+  TEST_Check(MBED_LCD_SetInvertAsync(false, NULL), "async command queued");
+  MBED_LCD_EndFrame(true);                              // returns only after acknowledgement
+  TEST_Check(m_framesDone == 1, "published frame acknowledged");
+  TEST_Check(TEST_CompareLCD(m_model, "acknowledged frame"), "acknowledged frame");
+
+  MBED_LCD_WaitFrame();                                 // nothing more to wait for
+  TEST_Check(m_framesDone == 1, "no extra acknowledgement");
+  MBED_LCD_SetFrameCallback(NULL);
+}
+
+int main(void)
+{
+  MBED_LCD_init();
+
+  TEST_Clip();
+  TEST_Bitmap();
+  TEST_TallFont();
+  TEST_ImageRLE();
+#ifndef USE_DMA_REFRESH
+  TEST_StreamRLE();
+#endif
+  TEST_TruncatedRLE();
+#ifndef MBED_LCD_BAND_MODE
+  TEST_Scroll();
+#else
+  TEST_Check(!MBED_LCD_BandListOverflow(), "band list");
+#endif
+#ifdef MBED_LCD_OVERLAY
+  TEST_Overlay();
+#endif
+#ifdef USE_DMA_REFRESH
+  TEST_AsyncCommandFrame();
+#endif
+  TEST_FrameAcknowledged();
+
+  printf("%d of %d checks failed\n", m_failed, m_checks);
+  return m_failed;
+}
@@ -0,0 +1,294 @@
+/*
+ * mbed_lcd_font.c
+ *
+ * Host tool - converts BDF bitmap font to MBED_LCD_Font_t for MBED_LCD_SetFont()
+ * Output is C source with const arrays (flash), see format in mbed_shield_lcd.h
+ * Include generated file in one source file of application only, other ones use extern declaration
+ *
+ * Usage: mbed_lcd_font [-n name] [-p] [-s spacing] [-r first-last] [-c chars] [-t textfile] [-m code] input.bdf > output.h
+ *   -p  proportional, empty columns of each glyph are trimmed
+ *   -s  empty columns drawn after each glyph
+ *   -r  range of codes (default 32-126), -c and -t keep only listed characters / characters used in text file
+ *   -m  code drawn for characters not in font (default '?')
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define FONT_MAX_CODES  256               ///< Codes and glyph indexes are stored in one byte
+#define FONT_MAX_WIDTH  32                ///< Columns of glyph
+#define FONT_MAX_HEIGHT 32                ///< Rows of glyph (4 bands)
+
+typedef struct
+{
+  bool defined;
+  int width;                              ///< Advance (DWIDTH), trimmed width for proportional
+  uint32_t rows[FONT_MAX_HEIGHT];         ///< Cell rows, bit 0 = left column
+} Glyph_t;
+
+static Glyph_t m_glyphs[FONT_MAX_CODES];
+static int m_height, m_width;             ///< Cell of font
+static int m_ascent;
+
+/**
+ * Read BDF glyphs with encoding 0 .. 255 into cells of font (baseline at ascent)
+ */
+static bool BDF_Load(const char *fileName)
+{
+  FILE *f = fopen(fileName, "r");
+  char line[256];
+  int descent = -1, code = -1, dw = 0, bw = 0, bh = 0, bx = 0, by = 0, row = -1;
+
+  if (f == NULL)
+    return false;
+
+  m_ascent = -1;
+  while (fgets(line, sizeof(line), f) != NULL)
+  {
+    if (sscanf(line, "FONTBOUNDINGBOX %d %d %d %d", &bw, &bh, &bx, &by) == 4)
+    {
+      m_width = bw;
+      if (m_ascent < 0)                   // FONT_ASCENT / DESCENT has preference
+      {
+        m_ascent = bh + by;
+        descent = -by;
+      }
+    }
+    else if (sscanf(line, "FONT_ASCENT %d", &m_ascent) == 1)
+      ;
+    else if (sscanf(line, "FONT_DESCENT %d", &descent) == 1)
+      ;
+    else if (strncmp(line, "STARTCHAR", 9) == 0)
+    {
+      code = -1;
+      dw = m_width;
+    }
+    else if (sscanf(line, "ENCODING %d", &code) == 1)
+      ;
+    else if (sscanf(line, "DWIDTH %d", &dw) == 1)
+      ;
+    else if (sscanf(line, "BBX %d %d %d %d", &bw, &bh, &bx, &by) == 4)
+      ;
+    else if (strncmp(line, "BITMAP", 6) == 0)
+    {
+      row = 0;
+      if ((code >= 0) && (code < FONT_MAX_CODES))
+      {
+        m_glyphs[code].defined = true;
+        m_glyphs[code].width = dw;
+      }
+    }
+    else if (strncmp(line, "ENDCHAR", 7) == 0)
+      row = -1;
+    else if ((row >= 0) && (code >= 0) && (code < FONT_MAX_CODES))
+    {
+      unsigned long bits = strtoul(line, NULL, 16);
+      int digits = strspn(line, "0123456789abcdefABCDEF");
+      int y = m_ascent - (by + bh) + row++;   // BBX offset is from baseline to bottom of glyph
+
+      for (int x = 0; x < bw; x++)
+        if ((bits >> (digits * 4 - 1 - x)) & 1)
+        {
+          if ((y < 0) || (y >= FONT_MAX_HEIGHT) || (bx + x < 0) || (bx + x >= FONT_MAX_WIDTH))
+            goto fail;
+          m_glyphs[code].rows[y] |= 1u << (bx + x);
+        }
+    }
+  }
+
+  fclose(f);
+  m_height = m_ascent + descent;
+  return (m_ascent >= 0) && (m_height > 0) && (m_height <= FONT_MAX_HEIGHT) && (m_width > 0) && (m_width <= FONT_MAX_WIDTH);
+
+fail:
+  fclose(f);
+  return false;
+}
+
+/**
+ * Trim empty columns of glyph, left ones are shifted out. Empty glyph (space) keeps its advance
+ */
+static void Glyph_Trim(Glyph_t *g, int spacing)
+{
+  uint32_t used = 0;
+  int left = 0, right = 0;
+
+  for (int y = 0; y < m_height; y++)
+    used |= g->rows[y];
+
+  if (used == 0)
+  {
+    g->width = (g->width > spacing + 1) ? g->width - spacing : 1;
+    return;
+  }
+
+  while (!(used & (1u << left)))
+    left++;
+  while (used >> (right + 1))
+    right++;
+
+  for (int y = 0; y < m_height; y++)
+    g->rows[y] >>= left;
+  g->width = right - left + 1;
+}
+
+int main(int argc, char *argv[])
+{
+  const char *name = "font";
+  const char *fileName = NULL;
+  const char *chars = NULL;
+  const char *textFile = NULL;
+  bool proportional = false, subset, used[FONT_MAX_CODES] = { false };
+  int spacing = 0, first = 32, last = 126, missing = '?';
+  int count = 0, size = 0, bands, maxWidth = 0, missingIndex = 0;
+  uint8_t codes[FONT_MAX_CODES];
+
+  for (int a = 1; a < argc; a++)
+  {
+    if ((strcmp(argv[a], "-n") == 0) && (a + 1 < argc))
+      name = argv[++a];
+    else if (strcmp(argv[a], "-p") == 0)
+      proportional = true;
+    else if ((strcmp(argv[a], "-s") == 0) && (a + 1 < argc))
+      spacing = atoi(argv[++a]);
+    else if ((strcmp(argv[a], "-r") == 0) && (a + 1 < argc))
+      sscanf(argv[++a], "%d-%d", &first, &last);
+    else if ((strcmp(argv[a], "-c") == 0) && (a + 1 < argc))
+      chars = argv[++a];
+    else if ((strcmp(argv[a], "-t") == 0) && (a + 1 < argc))
+      textFile = argv[++a];
+    else if ((strcmp(argv[a], "-m") == 0) && (a + 1 < argc))
+      missing = (uint8_t)argv[++a][0];
+    else
+      fileName = argv[a];
+  }
+
+  if ((fileName == NULL) || (first < 0) || (last >= FONT_MAX_CODES) || (first > last) || (spacing < 0) || (spacing > 8))
+  {
+    fprintf(stderr, "usage: %s [-n name] [-p] [-s spacing] [-r first-last] [-c chars] [-t textfile] [-m code] input.bdf > output.h\n", argv[0]);
+    return 2;
+  }
+
+  subset = (chars != NULL) || (textFile != NULL);
+  if (!BDF_Load(fileName))
+  {
+    fprintf(stderr, "%s: can not read BDF font (max. %d x %d)\n", fileName, FONT_MAX_WIDTH, FONT_MAX_HEIGHT);
+    return 1;
+  }
+
+  if (subset)                                           // codes are listed
+  {
+    if (chars != NULL)
+      for (; *chars; chars++)
+        used[(uint8_t)*chars] = true;
+
+    if (textFile != NULL)
+    {
+      FILE *f = fopen(textFile, "rb");
+      int c;
+
+      if (f == NULL)
+      {
+        fprintf(stderr, "%s: can not read text\n", textFile);
+        return 1;
+      }
+      while ((c = fgetc(f)) != EOF)
+        if (c >= ' ')                                   // control characters (line ends) are not drawn
+          used[c] = true;
+      fclose(f);
+    }
+
+    used[missing] = true;
+    for (int c = 0; c < FONT_MAX_CODES; c++)
+      if (used[c])
+        codes[count++] = c;
+  }
+  else
+  {
+    for (int c = first; c <= last; c++)
+      codes[count++] = c;
+  }
+
+  for (int i = 0; i < count; i++)
+  {
+    Glyph_t *g = &m_glyphs[codes[i]];
+
+    if (!g->defined)
+    {
+      if (subset)
+        fprintf(stderr, "%s: code %d not in font\n", fileName, codes[i]);
+      g->width = m_width;
+    }
+    if (proportional)
+      Glyph_Trim(g, spacing);
+    else
+      g->width = m_width;
+
+    if (g->width > maxWidth)
+      maxWidth = g->width;
+    if (codes[i] == missing)
+      missingIndex = i;
+  }
+
+  bands = (m_height + 7) / 8;
+  for (int i = 0; i < count; i++)
+    size += m_glyphs[codes[i]].width * bands;
+
+  printf("/* %s - %s, %d glyphs, %d rows, %s, %d bytes of glyphs */\n",
+      name, fileName, count, m_height, proportional ? "proportional" : "monospaced", size);
+  printf("#include <stddef.h>\n#include \"mbed_shield_lcd.h\"\n\n");
+
+  printf("static const uint8_t %s_data[%d] =\n{", name, size);
+  for (int i = 0, n = 0; i < count; i++)
+  {
+    Glyph_t *g = &m_glyphs[codes[i]];
+
+    for (int b = 0; b < bands; b++)
+      for (int x = 0; x < g->width; x++)
+      {
+        uint8_t byte = 0;
+
+        for (int r = 0; (r < 8) && (b * 8 + r < m_height); r++)
+          if (g->rows[b * 8 + r] & (1u << x))
+            byte |= 1 << r;
+
+        printf("%s0x%02X%s", (n % 16) ? " " : "\n  ", byte, (n + 1 < size) ? "," : "");
+        n++;
+      }
+  }
+  printf("\n};\n\n");
+
+  if (subset)
+  {
+    printf("static const uint8_t %s_codes[%d] =\n{", name, count);
+    for (int i = 0; i < count; i++)
+      printf("%s%3d%s", (i % 16) ? " " : "\n  ", codes[i], (i + 1 < count) ? "," : "");
+    printf("\n};\n\n");
+  }
+
+  if (proportional)
+  {
+    printf("static const uint8_t %s_widths[%d] =\n{", name, count);
+    for (int i = 0; i < count; i++)
+      printf("%s%2d%s", (i % 16) ? " " : "\n  ", m_glyphs[codes[i]].width, (i + 1 < count) ? "," : "");
+    printf("\n};\n\n");
+
+    printf("static const uint16_t %s_offsets[%d] =\n{", name, count);
+    for (int i = 0, o = 0; i < count; i++)
+    {
+      printf("%s%4d%s", (i % 16) ? " " : "\n  ", o, (i + 1 < count) ? "," : "");
+      o += m_glyphs[codes[i]].width * bands;
+    }
+    printf("\n};\n\n");
+  }
+
+  printf("const MBED_LCD_Font_t %s = { %d, %d, %d, %d, %d, %d, %s%s, %s%s, %s%s, %s_data };\n",
+      name, m_height, maxWidth, spacing, missingIndex, subset ? 0 : first, count,
+      subset ? name : "NULL", subset ? "_codes" : "",
+      proportional ? name : "NULL", proportional ? "_widths" : "",
+      proportional ? name : "NULL", proportional ? "_offsets" : "", name);
+  return 0;
+}
@@ -0,0 +1,198 @@
+/*
+ * mbed_lcd_rle.c
+ *
+ * Host tool - converts PBM image (P1 or P4, 1 = black) to compressed image for MBED_LCD_DrawImageRLE()
+ * Output is C source with const array, see format in mbed_shield_lcd.h
+ *
+ * Usage: mbed_lcd_rle [-n name] input.pbm > output.h
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <ctype.h>
+
+#define RLE_MAX_WIDTH   255               ///< Width is stored in one byte
+#define RLE_MAX_PAGES   255
+
+/**
+ * Next number from PBM header, comments (#) are skipped
+ */
+static int PBM_ReadNumber(FILE *f)
+{
+  int c, val = 0;
+
+  do
+  {
+    c = fgetc(f);
+    if (c == '#')
+      while ((c != '\n') && (c != EOF))
+        c = fgetc(f);
+  } while (isspace(c));
+
+  if (!isdigit(c))
+    return -1;
+
+  for (; isdigit(c); c = fgetc(f))
+    val = val * 10 + (c - '0');
+
+  return val;                             // one whitespace after number is consumed
+}
+
+/**
+ * Read PBM to page format (byte = column, LSB on top), height is padded to whole pages by 0
+ */
+static uint8_t *PBM_Load(const char *fileName, int *width, int *pages)
+{
+  FILE *f = fopen(fileName, "rb");
+  uint8_t *img = NULL;
+  int w, h, binary;
+
+  if (f == NULL)
+    return NULL;
+
+  if ((fgetc(f) != 'P') || ((binary = fgetc(f)) != '1' && binary != '4'))
+    goto fail;
+
+  binary = (binary == '4');
+  w = PBM_ReadNumber(f);
+  h = PBM_ReadNumber(f);
+  if ((w < 1) || (w > RLE_MAX_WIDTH) || (h < 1) || ((h + 7) / 8 > RLE_MAX_PAGES))
+    goto fail;
+
+  *width = w;
+  *pages = (h + 7) / 8;
+  img = calloc(*pages * w, 1);
+  if (img == NULL)
+    goto fail;
+
+  for (int y = 0; y < h; y++)
+  {
+    int byte = 0;
+
+    for (int x = 0; x < w; x++)
+    {
+      int bit;
+
+      if (binary)                         // rows padded to whole bytes, MSB on left
+      {
+        if ((x % 8) == 0)
+          byte = fgetc(f);
+        if (byte == EOF)
+          goto fail;
+        bit = (byte >> (7 - x % 8)) & 1;
+      }
+      else
+      {
+        int c;
+
+        do
+        {
+          c = fgetc(f);
+        } while (isspace(c));
+        if ((c != '0') && (c != '1'))
+          goto fail;
+        bit = (c == '1');
+      }
+
+      if (bit)
+        img[(y / 8) * w + x] |= 1 << (y % 8);
+    }
+  }
+
+  fclose(f);
+  return img;
+
+fail:
+  free(img);
+  fclose(f);
+  return NULL;
+}
+
+/**
+ * Pack bytes by runs - repeated byte (2 .. 129 times) or literal block (1 .. 128 bytes)
+ * Returns size of output, out must have space for len + len / 128 + 1 bytes
+ */
+static int RLE_Encode(const uint8_t *in, int len, uint8_t *out)
+{
+  int o = 0, i = 0, lit = -1;             // lit = position of count of open literal block
+
+  while (i < len)
+  {
+    int run = 1;
+
+    while ((i + run < len) && (in[i + run] == in[i]) && (run < 129))
+      run++;
+
+    if ((run >= 3) || ((run == 2) && (lit < 0)))
+    {
+      out[o++] = 0x80 + run - 2;          // 128 = 2 times
+      out[o++] = in[i];
+      i += run;
+      lit = -1;
+    }
+    else
+    {
+      if ((lit < 0) || (out[lit] == 0x7F))
+      {
+        lit = o;
+        out[o++] = 0;                     // 1 byte, incremented by next ones
+      }
+      else
+        out[lit]++;
+
+      out[o++] = in[i++];
+    }
+  }
+
+  return o;
+}
+
+int main(int argc, char *argv[])
+{
+  const char *name = "image";
+  const char *fileName = NULL;
+  uint8_t *img, *rle;
+  int width, pages, len;
+
+  for (int a = 1; a < argc; a++)
+  {
+    if ((strcmp(argv[a], "-n") == 0) && (a + 1 < argc))
+      name = argv[++a];
+    else
+      fileName = argv[a];
+  }
+
+  if (fileName == NULL)
+  {
+    fprintf(stderr, "usage: %s [-n name] input.pbm > output.h\n", argv[0]);
+    return 2;
+  }
+
+  img = PBM_Load(fileName, &width, &pages);
+  if (img == NULL)
+  {
+    fprintf(stderr, "%s: can not read PBM image (max. %d x %d)\n", fileName, RLE_MAX_WIDTH, RLE_MAX_PAGES * 8);
+    return 1;
+  }
+
+  rle = malloc(2 + width * pages + width * pages / 128 + 1);
+  if (rle == NULL)
+    return 1;
+
+  rle[0] = width;
+  rle[1] = pages;
+  len = 2 + RLE_Encode(img, width * pages, &rle[2]);
+
+  printf("/* %s - %d x %d pixels, %d bytes (raw %d), for MBED_LCD_DrawImageRLE() */\n",
+      fileName, width, pages * 8, len, width * pages);
+  printf("const uint8_t %s[%d] =\n{", name, len);
+  for (int i = 0; i < len; i++)
+    printf("%s0x%02X%s", (i % 16) ? " " : "\n  ", rle[i], (i + 1 < len) ? "," : "");
+  printf("\n};\n");
+
+  free(rle);
+  free(img);
+  return 0;
+}